@@ -503,6 +503,7 @@ action_t::action_t( action_e       ty,
   pre_execute_state(),
   snapshot_flags(),
   update_flags( STATE_TGT_MUL_DA | STATE_TGT_MUL_TA | STATE_TGT_CRIT),
+  custom_snapshot( false ),
   target_cache(),
   options(),
   state_cache(),
@@ -511,6 +512,8 @@ action_t::action_t( action_e       ty,
   assert( option.cycle_targets == 0 );
   assert( !name_str.empty() && "Abilities must have valid name_str entries!!" );
 
+  crn_stream.key = sim -> crn_key( player -> name_str + "/action/" + name_str );
+
   if ( sim -> initialized )
   {
     sim -> errorf( "Player %s action %s created after simulator initialization.",
@@ -1452,13 +1455,29 @@ void action_t::execute()
   {
     std::vector< player_t* >& tl = target_list();
     num_targets = ( n_targets() < 0 ) ? tl.size() : std::min( tl.size(), as<size_t>( n_targets() ) );
+
+    // With aoe_snapshot_once, the source side state is snapshot once (against the first target)
+    // and copied to every target, the same way a pre-execute state is. Actions with a custom
+    // snapshot always snapshot every target in full.
+    action_state_t* source_state = nullptr;
+    if ( ! pre_execute_state && sim -> aoe_snapshot_once && ! custom_snapshot &&
+         num_targets > 1 && ! tl.empty() )
+    {
+      source_state = get_state();
+      source_state -> target = tl[ 0 ];
+      source_state -> n_targets = std::min( num_targets, tl.size() );
+      source_state -> chain_target = 0;
+      snapshot_internal( source_state, snapshot_flags & ~STATE_TARGET, amount_type( source_state ) );
+    }
+    const action_state_t* base_state = pre_execute_state ? pre_execute_state : source_state;
+
     for ( size_t t = 0, max_targets = tl.size(); t < num_targets && t < max_targets; t++ )
     {
-      action_state_t* s = get_state( pre_execute_state );
+      action_state_t* s = get_state( base_state );
       s -> target = tl[ t ];
       s -> n_targets = std::min( num_targets, tl.size() );
       s -> chain_target = as<int>( t );
-      if ( ! pre_execute_state )
+      if ( ! base_state )
       {
         snapshot_state( s, amount_type( s ) );
       }
@@ -1478,6 +1497,9 @@ void action_t::execute()
 
       schedule_travel( s );
     }
+
+    if ( source_state )
+      action_state_t::release( source_state );
   }
   else // single target
   {
@@ -1535,13 +1557,13 @@ void action_t::execute()
       // "On spell cast", only performed for foreground actions
       if ( ( pt2 = execute_state -> cast_proc_type2() ) != PROC2_INVALID )
       {
-        action_callback_t::trigger( player -> callbacks.procs[ pt ][ pt2 ], this, execute_state );
+        trigger_proc_callbacks( pt, pt2, execute_state );
       }
 
       // "On an execute result"
       if ( ( pt2 = execute_state -> execute_proc_type2() ) != PROC2_INVALID )
       {
-        action_callback_t::trigger( player -> callbacks.procs[ pt ][ pt2 ], this, execute_state );
+        trigger_proc_callbacks( pt, pt2, execute_state );
       }
     }
   }
@@ -2058,12 +2080,70 @@ bool action_t::ready()
   if ( rng().roll( false_positive_pct() ) )
     return true;
 
-  if ( if_expr && !if_expr -> success() )
+  if ( if_expr && ! if_expr_ready() )
     return false;
 
   return true;
 }
 
+// action_t::if_expr_ready ==================================================
+
+bool action_t::if_expr_ready()
+{
+  // Expressions are cached once optimized, at the start of the second iteration
+  if ( ! sim -> cache_action_readiness || sim -> current_iteration < 1 )
+  {
+    return if_expr -> success();
+  }
+
+  if_expr_cache_t& cache = if_expr_cache;
+  if ( cache.valid && cache.target == target && sim -> current_time() < cache.dependencies.valid_until )
+  {
+    bool unchanged = true;
+    for ( size_t i = 0; unchanged && i < cache.versions.size(); ++i )
+    {
+      unchanged = *cache.dependencies.versions[ i ] == cache.versions[ i ];
+    }
+    for ( size_t i = 0; unchanged && i < cache.values.size(); ++i )
+    {
+      unchanged = *cache.dependencies.values[ i ] == cache.values[ i ];
+    }
+
+    if ( unchanged )
+    {
+      player -> ready_evaluations_saved++;
+      return false;
+    }
+  }
+
+  player -> ready_evaluations++;
+  cache.valid = false;
+
+  if ( if_expr -> success() )
+  {
+    return true;
+  }
+
+  cache.dependencies.clear();
+  if ( if_expr -> dependencies( cache.dependencies ) )
+  {
+    cache.valid = true;
+    cache.target = target;
+    cache.versions.clear();
+    for ( auto version : cache.dependencies.versions )
+    {
+      cache.versions.push_back( *version );
+    }
+    cache.values.clear();
+    for ( auto value : cache.dependencies.values )
+    {
+      cache.values.push_back( *value );
+    }
+  }
+
+  return false;
+}
+
 // action_t::init ===========================================================
 
 void action_t::init()
@@ -2293,6 +2373,7 @@ void action_t::reset()
   interrupt_immediate_occurred = false;
   travel_events.clear();
   target = default_target;
+  if_expr_cache.valid = false;
 
   if( sim -> current_iteration == 1 )
   {
@@ -2313,6 +2394,15 @@ void action_t::reset()
     if ( target_if_expr ) target_if_expr = target_if_expr -> optimize();
     if( interrupt_if_expr ) interrupt_if_expr = interrupt_if_expr -> optimize();
     if( early_chain_if_expr ) early_chain_if_expr = early_chain_if_expr -> optimize();
+
+    // Lower the (optimized) expressions into bytecode
+    if ( sim -> compile_expressions )
+    {
+      if_expr = expression::compile( if_expr );
+      target_if_expr = expression::compile( target_if_expr );
+      interrupt_if_expr = expression::compile( interrupt_if_expr );
+      early_chain_if_expr = expression::compile( early_chain_if_expr );
+    }
   }
 }
 
@@ -3434,6 +3524,51 @@ void action_t::remove_travel_event( travel_event_t* e )
     erase_unordered( travel_events, pos );
 }
 
+void action_t::init_proc_callbacks()
+{
+  if ( ! proc_callbacks )
+    proc_callbacks = std::unique_ptr<proc_callback_list_t>( new proc_callback_list_t() );
+
+  auto& list = *proc_callbacks;
+  list.version = player -> callbacks.version;
+  list.weapon = weapon;
+  list.callbacks.clear();
+
+  for ( proc_types pt = PROC1_TYPE_MIN; pt < PROC1_TYPE_MAX; pt++ )
+  {
+    for ( proc_types2 pt2 = PROC2_TYPE_MIN; pt2 < PROC2_TYPE_MAX; pt2++ )
+    {
+      list.offsets[ pt * PROC2_TYPE_MAX + pt2 ] = as<unsigned>( list.callbacks.size() );
+
+      for ( auto cb : player -> callbacks.procs[ pt ][ pt2 ] )
+      {
+        // Callbacks that disallow procs stop the whole dispatch for proc actions, so they have to
+        // stay in the list of those regardless of the filter.
+        if ( cb -> can_proc( this ) || ( proc && ! cb -> allow_procs ) )
+          list.callbacks.push_back( cb );
+      }
+    }
+  }
+
+  list.offsets.back() = as<unsigned>( list.callbacks.size() );
+}
+
+void action_t::trigger_proc_callbacks( proc_types pt, proc_types2 pt2, action_state_t* state )
+{
+  if ( ! proc_callbacks || proc_callbacks -> version != player -> callbacks.version ||
+       proc_callbacks -> weapon != weapon )
+  {
+    init_proc_callbacks();
+  }
+
+  size_t idx = pt * PROC2_TYPE_MAX + pt2;
+  size_t first = proc_callbacks -> offsets[ idx ], last = proc_callbacks -> offsets[ idx + 1 ];
+  if ( first == last )
+    return;
+
+  action_callback_t::trigger( proc_callbacks -> callbacks, first, last, this, state );
+}
+
 void action_t::do_teleport( action_state_t* state )
 {
   player -> teleport( composite_teleport_distance( state ) );
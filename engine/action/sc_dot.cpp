@@ -17,6 +17,7 @@ dot_t::dot_t( const std::string& n, player_t* t, player_t* s )
     extended_time( timespan_t::zero() ),
     reduced_time( timespan_t::zero() ),
     stack( 0 ),
+    stack_version( 0 ),
     tick_event( nullptr ),
     end_event( nullptr ),
     last_tick_factor( -1.0 ),
@@ -173,6 +174,7 @@ void dot_t::reset()
   stack            = 0;
   extended_time    = timespan_t::zero();
   ticking          = false;
+  stack_version++;
   miss_time        = timespan_t::min();
   last_start       = timespan_t::min();
   current_duration = timespan_t::min();
@@ -215,6 +217,7 @@ void dot_t::decrement( int stacks = 1 )
   else
   {
     stack -= stacks;
+    stack_version++;
 
     if ( sim.debug )
       sim.out_debug.printf( "dot %s decremented by %d to %d stacks",
@@ -325,6 +328,7 @@ void dot_t::copy( player_t* other_target, dot_copy_e copy_type ) const
         as<int>( std::ceil( computed_tick_duration / time_to_tick ) );
 
     other_dot->ticking = true;
+    other_dot->stack_version++;
     other_dot->end_event =
         make_event<dot_end_event_t>( sim, other_dot, new_duration );
 
@@ -429,6 +433,7 @@ void dot_t::copy( dot_t* other_dot ) const
       as<int>( std::ceil( computed_tick_duration / time_to_tick ) );
 
   other_dot->ticking   = true;
+  other_dot->stack_version++;
   other_dot->end_event = make_event<dot_end_event_t>( sim, other_dot, new_duration );
 
   other_dot->last_tick_factor = other_dot->current_action->last_tick_factor(
@@ -480,6 +485,18 @@ expr_t* dot_t::create_expression( action_t* action, const std::string& name_str,
         dot = action->target->get_dot( static_dot->name(), action->player );
       return dot;
     }
+
+    // Track the ticking state and stack count of the dot read. Dots not resolved for the
+    // current target yet are not tracked.
+    bool stack_dependencies( expr_dependencies_t& deps ) const
+    {
+      dot_t* d = dynamic ? specific_dot[ action->target ] : static_dot;
+      if ( !d )
+        return false;
+
+      deps.add( d->stack_version );
+      return true;
+    }
   };
 
   if ( name_str == "ticks" )
@@ -696,6 +713,10 @@ expr_t* dot_t::create_expression( action_t* action, const std::string& name_str,
       {
         return dot()->ticking;
       }
+      bool dependencies( expr_dependencies_t& deps ) override
+      {
+        return stack_dependencies( deps );
+      }
     };
     return new ticking_expr_t( this, action, dynamic );
   }
@@ -830,6 +851,10 @@ expr_t* dot_t::create_expression( action_t* action, const std::string& name_str,
       {
         return dot()->current_stack();
       }
+      bool dependencies( expr_dependencies_t& deps ) override
+      {
+        return stack_dependencies( deps );
+      }
     };
     return new dot_stack_expr_t( this, action, dynamic );
   }
@@ -1072,6 +1097,7 @@ void dot_t::start( timespan_t duration )
 
   ticking = true;
   stack   = 1;
+  stack_version++;
 
   end_event = make_event<dot_end_event_t>( sim, this, current_duration );
 
@@ -1105,7 +1131,10 @@ void dot_t::refresh( timespan_t duration )
   last_start = sim.current_time();
 
   if ( stack < max_stack )
+  {
     stack++;
+    stack_version++;
+  }
 
   assert( end_event && "Dot is ticking but has no end event." );
   timespan_t remaining_duration = end_event->remains();
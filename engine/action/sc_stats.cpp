@@ -43,6 +43,14 @@ stats_t::stats_t( const std::string& n, player_t* p ) :
   scaling( nullptr ),
   timeline_amount( nullptr )
 {
+  if ( sim.streaming_statistics )
+  {
+    actual_amount.change_streaming( true );
+    total_amount.change_streaming( true );
+    portion_aps.change_streaming( true );
+    portion_apse.change_streaming( true );
+  }
+
   int size = std::min( sim.iterations, 10000 );
   actual_amount.reserve( size );
   total_amount.reserve( size );
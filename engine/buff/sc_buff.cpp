@@ -201,6 +201,20 @@ struct buff_expr_t : public expr_t
     return buff;
   }
 
+  // Track the stack count of the buff read, for expressions derived from it alone. Buffs not
+  // resolved for the current target yet are not tracked, to avoid creating them here.
+  bool stack_dependencies( expr_dependencies_t& deps ) const
+  {
+    buff_t* b = static_buff ? static_buff : specific_buff[ action -> target ];
+    if ( ! b )
+    {
+      return false;
+    }
+
+    deps.add( b -> stack_version );
+    return true;
+  }
+
   bool is_constant( double *v ) override
   {
     // Background action, so no need to check anything. This is for sure constant.
@@ -261,6 +275,7 @@ buff_t::buff_t( const buff_creation::buff_creator_basics_t& params ) :
   manual_chance_used( false ),
   current_value(),
   current_stack(),
+  stack_version(),
   buff_duration( params._duration ),
   default_chance( 1.0 ),
   current_tick( 0 ),
@@ -295,6 +310,8 @@ buff_t::buff_t( const buff_creation::buff_creator_basics_t& params ) :
   trigger_intervals(),
   change_regen_rate( false )
 {
+  crn_stream.key = sim -> crn_key( source_name() + "/buff/" + name_str );
+
   if ( source ) // Player Buffs
   {
     player -> buff_list.push_back( this );
@@ -1072,6 +1089,7 @@ void buff_t::decrement( int    stacks,
       stack_uptime[ current_stack ].update( false, sim -> current_time() );
 
     current_stack -= stacks;
+    stack_version++;
 
     if ( value == DEFAULT_VALUE() && default_value != DEFAULT_VALUE() )
       value = default_value;
@@ -1330,12 +1348,14 @@ void buff_t::bump( int stacks, double value )
   if ( max_stack() < 0 )
   {
     current_stack += stacks;
+    stack_version++;
   }
   else if ( current_stack < max_stack() )
   {
     int before_stack = current_stack;
 
     current_stack += stacks;
+    stack_version++;
     if ( current_stack > max_stack() )
     {
       int overflow = current_stack - max_stack();
@@ -1343,6 +1363,7 @@ void buff_t::bump( int stacks, double value )
       overflow_count++;
       overflow_total += overflow;
       current_stack = max_stack();
+      stack_version++;
 
       if ( stack_behavior == BUFF_STACK_ASYNCHRONOUS )
       {
@@ -1508,6 +1529,7 @@ void buff_t::expire( timespan_t delay )
   int old_stack = current_stack;
 
   current_stack = 0;
+  stack_version++;
   if ( requires_invalidation ) invalidate_cache();
   if ( last_start >= timespan_t::zero() )
   {
@@ -1808,6 +1830,7 @@ expr_t* buff_t::create_expression(  std::string buff_name,
       up_expr_t( std::string bn, action_t* a, buff_t* b ) :
         buff_expr_t( "buff_up", bn, a, b ) {}
       virtual double evaluate() override { return buff() -> check() > 0; }
+      bool dependencies( expr_dependencies_t& deps ) override { return stack_dependencies( deps ); }
     };
     return new up_expr_t( buff_name, action, static_buff );
   }
@@ -1818,6 +1841,7 @@ expr_t* buff_t::create_expression(  std::string buff_name,
       down_expr_t( std::string bn, action_t* a, buff_t* b ) :
         buff_expr_t( "buff_down", bn, a, b, 1.0 ) {}
       virtual double evaluate() override { return buff() -> check() <= 0; }
+      bool dependencies( expr_dependencies_t& deps ) override { return stack_dependencies( deps ); }
     };
     return new down_expr_t( buff_name, action, static_buff );
   }
@@ -1828,6 +1852,7 @@ expr_t* buff_t::create_expression(  std::string buff_name,
       stack_expr_t( std::string bn, action_t* a, buff_t* b ) :
         buff_expr_t( "buff_stack", bn, a, b ) {}
       virtual double evaluate() override { return buff() -> check(); }
+      bool dependencies( expr_dependencies_t& deps ) override { return stack_dependencies( deps ); }
     };
     return new stack_expr_t( buff_name, action, static_buff );
   }
@@ -1838,6 +1863,7 @@ expr_t* buff_t::create_expression(  std::string buff_name,
       stack_pct_expr_t( std::string bn, action_t* a, buff_t* b ) :
         buff_expr_t( "buff_stack_pct", bn, a, b ) {}
       virtual double evaluate() override { return 100.0 * buff() -> check() / buff() -> max_stack(); }
+      bool dependencies( expr_dependencies_t& deps ) override { return stack_dependencies( deps ); }
     };
     return new stack_pct_expr_t( buff_name, action, static_buff );
   }
@@ -2065,6 +2091,7 @@ void stat_buff_t::decrement( int stacks, double /* value */ )
       stats[ i ].current_value -= delta;
     }
     current_stack -= stacks;
+    stack_version++;
 
     invalidate_cache();
 
@@ -2157,6 +2184,7 @@ void cost_reduction_buff_t::decrement( int stacks, double /* value */ )
     double delta = amount * stacks;
     player -> cost_reduction_loss( school, delta );
     current_stack -= stacks;
+    stack_version++;
     current_value -= delta;
   }
 }
@@ -1034,7 +1034,7 @@ public:
     death_knight_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new death_knight_td_t( target, const_cast<death_knight_t*>(this) );
+      td = target_data.construct( target, const_cast<death_knight_t*>(this) );
     }
     return td;
   }
@@ -3225,6 +3225,8 @@ struct blade_dance_attack_t : public demon_hunter_attack_t
   {
     dual = background = true;
     aoe = -1;
+    // First Blood applies to the primary target only
+    custom_snapshot = true;
     first_blood_multiplier =
       1.0 + p -> talent.first_blood -> effectN( 1 ).percent();
   }
@@ -3334,6 +3336,7 @@ struct blade_dance_base_t : public demon_hunter_attack_t
     : demon_hunter_attack_t( n, p, s, options_str ), dodge_buff( nullptr )
   {
     may_miss = may_crit = may_parry = may_block = may_dodge = false;
+    custom_snapshot = true; // First Blood applies to the primary target only
     cooldown = p -> get_cooldown( "blade_dance" );  // shared cooldown
     // Disallow use outside of melee range.
     range = 5.0;
@@ -3637,6 +3640,7 @@ struct chaos_strike_base_t : public demon_hunter_attack_t
                        const spell_data_t* s, const std::string& options_str = std::string())
     : demon_hunter_attack_t( n, p, s, options_str )
   {
+    custom_snapshot = true;
     energize_amount = p->spec.chaos_strike_refund->effectN(1).resource(RESOURCE_FURY);
     aoe = s->effectN(1).chain_target();
 
@@ -3907,6 +3911,7 @@ struct chaos_cleave_t : public demon_hunter_attack_t
     radius = 5;
     range = -1.0;
     school = SCHOOL_CHAOS;
+    custom_snapshot = true;
   }
 
   void snapshot_state(action_state_t* s, dmg_e rt) override
@@ -5547,6 +5552,9 @@ demon_hunter_t::demon_hunter_t(sim_t* sim, const std::string& name, race_e r)
     else // DEMON_HUNTER_VENGEANCE
       return spell->id() == 227174 /* Fallout */ && find_item(151639) != nullptr;
   });
+
+  // Dependent caches that invalidate_cache() reacts to
+  cache_hooks = ( uint64_t( 1 ) << CACHE_ATTACK_POWER ) | ( uint64_t( 1 ) << CACHE_DAMAGE_VERSATILITY );
 }
 
 demon_hunter_t::~demon_hunter_t()
@@ -7989,7 +7997,7 @@ demon_hunter_td_t* demon_hunter_t::get_target_data( player_t* target ) const
   auto& td = _target_data[ target ];
   if ( !td )
   {
-    td = new demon_hunter_td_t( target, const_cast<demon_hunter_t&>( *this ) );
+    td = _target_data.construct( target, const_cast<demon_hunter_t&>( *this ) );
   }
   return td;
 }
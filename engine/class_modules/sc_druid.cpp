@@ -819,6 +819,9 @@ public:
     talent_points.register_validity_fn( [ this ]( const spell_data_t* spell ) {
        return strcmp( spell->name_cstr() , "Soul of the Forest" ) == 0 && find_item( 151636 ) != nullptr;
     } );
+
+    // Dependent caches that invalidate_cache() reacts to
+    cache_hooks = ( uint64_t( 1 ) << CACHE_ATTACK_POWER );
   }
 
   virtual           ~druid_t();
@@ -3103,6 +3106,7 @@ struct ashamanes_rip_t : public cat_attack_t
     // Copies benefit from rip, so need to flag this as snapshotting so its damage doesn't get modified dynamically.
     snapshots_tf = true;
     snapshots_sr = false;
+    custom_snapshot = true;
 
     // "dot_behavior" will have no effect, see ashamanes_rip_t::impact()
       
@@ -5295,6 +5299,7 @@ struct fury_of_elune_t : public druid_spell_t
       druid_spell_t( "fury_of_elune_tick", player, player -> find_spell( 211545 ) )
     {
       background = dual = ground_aoe = true;
+      custom_snapshot = true;
     } 
     
     void snapshot_internal( action_state_t* state, unsigned flags, dmg_e rt ) override
@@ -9533,7 +9538,7 @@ druid_td_t* druid_t::get_target_data( player_t* target ) const
   druid_td_t*& td = target_data[ target ];
   if ( ! td )
   {
-    td = new druid_td_t( *target, const_cast<druid_t&>( *this ) );
+    td = target_data.construct( *target, const_cast<druid_t&>( *this ) );
   }
   return td;
 }
@@ -546,7 +546,7 @@ public:
   hunter_td_t* get_target_data( player_t* target ) const override
   {
     hunter_td_t*& td = target_data[target];
-    if ( !td ) td = new hunter_td_t( target, const_cast<hunter_t*>( this ) );
+    if ( !td ) td = target_data.construct( target, const_cast<hunter_t*>( this ) );
     return td;
   }
 };
@@ -1344,7 +1344,7 @@ public:
   {
     hunter_main_pet_td_t*& td = target_data[target];
     if ( !td )
-      td = new hunter_main_pet_td_t( target, const_cast<hunter_main_pet_t*>( this ) );
+      td = target_data.construct( target, const_cast<hunter_main_pet_t*>( this ) );
     return td;
   }
 
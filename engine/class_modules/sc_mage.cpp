@@ -774,7 +774,7 @@ public:
     mage_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new mage_td_t( target, const_cast<mage_t*>(this) );
+      td = target_data.construct( target, const_cast<mage_t*>(this) );
     }
     return td;
   }
@@ -1650,6 +1650,7 @@ public:
     may_crit      = true;
     tick_may_crit = true;
     weapon_multiplier = 0.0;
+    custom_snapshot = true;
     affected_by.ice_floes = data().affected_by( p -> talents.ice_floes -> effectN( 1 ) );
     track_cd_waste = data().cooldown() > timespan_t::zero() || data().charge_cooldown() > timespan_t::zero();
   }
@@ -6862,6 +6863,9 @@ mage_t::mage_t( sim_t* sim, const std::string& name, race_e r ) :
 
     return false;
   } );
+
+  // Dependent caches that invalidate_cache() reacts to
+  cache_hooks = ( uint64_t( 1 ) << CACHE_SPELL_CRIT_CHANCE );
 }
 
 
@@ -783,6 +783,9 @@ public:
 
       return false;
     } );
+
+    // Dependent caches that invalidate_cache() reacts to
+    cache_hooks = ( uint64_t( 1 ) << CACHE_SPELL_POWER );
   }
 
   // Default consumables
@@ -852,7 +855,7 @@ public:
     monk_td_t*& td = target_data[target];
     if ( !td )
     {
-      td = new monk_td_t( target, const_cast<monk_t*>( this ) );
+      td = target_data.construct( target, const_cast<monk_t*>( this ) );
     }
     return td;
   }
@@ -943,6 +946,7 @@ struct storm_earth_and_fire_pet_t : public pet_t
       // or do anything associated with "foreground actions".
       this -> background = this -> may_crit = true;
       this -> callbacks = false;
+      this -> custom_snapshot = true;
 
       // Cooldowns are handled automatically by the mirror abilities, the SEF specific ones need none.
       this -> cooldown -> duration = timespan_t::zero();
@@ -1810,7 +1814,7 @@ public:
     sef_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new sef_td_t( target, const_cast< storm_earth_and_fire_pet_t*>( this ) );
+      td = target_data.construct( target, const_cast< storm_earth_and_fire_pet_t*>( this ) );
     }
     return td;
   }
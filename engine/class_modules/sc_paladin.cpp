@@ -528,6 +528,9 @@ public:
 
     beacon_target = nullptr;
     regen_type = REGEN_DYNAMIC;
+
+    // Dependent caches that invalidate_cache() reacts to
+    cache_hooks = ( uint64_t( 1 ) << CACHE_ATTACK_POWER ) | ( uint64_t( 1 ) << CACHE_ATTACK_CRIT_CHANCE );
   }
 
   virtual void      init_base_stats() override;
@@ -619,7 +622,7 @@ public:
     paladin_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new paladin_td_t( target, const_cast<paladin_t*>(this) );
+      td = target_data.construct( target, const_cast<paladin_t*>(this) );
     }
     return td;
   }
@@ -2971,6 +2974,7 @@ struct eye_of_tyr_t : public paladin_spell_t
 	  if (p()->pillars_of_inmost_light)
 	  {
 		  p()->cooldowns.eye_of_tyr->ready += (p()->cooldowns.eye_of_tyr->duration * (p()->spells.pillars_of_inmost_light->effectN(2).percent()));
+		  p()->cooldowns.eye_of_tyr->version++;
 	  }
   }
 
@@ -3851,7 +3855,10 @@ struct hammer_of_justice_t : public paladin_melee_attack_t
     {
       damage_spell -> schedule_execute();
       if ( target -> health_percentage() > p() -> spells.justice_gaze -> effectN( 1 ).base_value() )
+      {
         p() -> cooldowns.hammer_of_justice -> ready -= ( p() -> cooldowns.hammer_of_justice -> duration * p() -> spells.justice_gaze -> effectN( 2 ).percent() );
+        p() -> cooldowns.hammer_of_justice -> version++;
+      }
 
       p() -> resource_gain( RESOURCE_HOLY_POWER, 1, p() -> gains.hp_justice_gaze );
     }
@@ -4112,6 +4119,7 @@ struct judgment_t : public paladin_melee_attack_t
     {
       double reduction = p() -> talents.fist_of_justice -> effectN( 1 ).base_value();
       p() -> cooldowns.hammer_of_justice -> ready -= timespan_t::from_seconds( reduction );
+      p() -> cooldowns.hammer_of_justice -> version++;
     }
     if ( p() -> sets -> has_set_bonus( PALADIN_RETRIBUTION, T20, B2 ) )
       p() -> buffs.sacred_judgment -> trigger();
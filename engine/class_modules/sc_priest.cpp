@@ -986,6 +986,7 @@ struct base_fiend_pet_t : public priest_pet_t
       // Ensure that it gets used after the first melee strike. In the combat logs that happen at the same time, but the
       // melee comes first.
       shadowcrawl_action->cooldown->ready = sim->current_time() + timespan_t::from_seconds( 0.001 );
+      shadowcrawl_action->cooldown->version++;
     }
   }
 
@@ -5351,7 +5352,7 @@ priest_td_t* priest_t::get_target_data( player_t* target ) const
   priest_td_t*& td = _target_data[ target ];
   if ( !td )
   {
-    td = new priest_td_t( target, const_cast<priest_t&>( *this ) );
+    td = _target_data.construct( target, const_cast<priest_t&>( *this ) );
   }
   return td;
 }
@@ -835,7 +835,7 @@ struct rogue_t : public player_t
     rogue_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new rogue_td_t( target, const_cast<rogue_t*>(this) );
+      td = target_data.construct( target, const_cast<rogue_t*>(this) );
     }
     return td;
   }
@@ -943,6 +943,7 @@ struct rogue_attack_t : public melee_attack_t
 
     may_crit = true;
     may_glance = false;
+    custom_snapshot = true;
     special = true;
     tick_may_crit = true;
     hasted_ticks = false;
@@ -624,6 +624,9 @@ public:
       }
       return false;
     } );
+
+    // Dependent caches that invalidate_cache() reacts to
+    cache_hooks = ( uint64_t( 1 ) << CACHE_ATTACK_POWER );
   }
 
   virtual           ~shaman_t();
@@ -718,7 +721,7 @@ public:
     shaman_td_t*& td = target_data[ target ];
     if ( ! td )
     {
-      td = new shaman_td_t( target, const_cast<shaman_t*>(this) );
+      td = target_data.construct( target, const_cast<shaman_t*>(this) );
     }
     return td;
   }
@@ -582,7 +582,7 @@ public:
     warlock_td_t*& td = target_data[target];
     if ( ! td )
     {
-      td = new warlock_td_t( target, const_cast<warlock_t&>( *this ) );
+      td = target_data.construct( target, const_cast<warlock_t&>( *this ) );
     }
     return td;
   }
@@ -1879,7 +1879,7 @@ namespace shadowy_tear {
     {
       shadowy_tear_td_t*& td = target_data[target];
       if ( !td )
-        td = new shadowy_tear_td_t( target, const_cast< shadowy_tear_t* >( this ) );
+        td = target_data.construct( target, const_cast< shadowy_tear_t* >( this ) );
       return td;
     }
 
@@ -1962,7 +1962,7 @@ namespace chaos_portal {
     {
       chaos_portal_td_t*& td = target_data[target];
       if ( !td )
-        td = new chaos_portal_td_t( target, const_cast< chaos_portal_t* >( this ) );
+        td = target_data.construct( target, const_cast< chaos_portal_t* >( this ) );
       return td;
     }
 
@@ -3940,6 +3940,7 @@ struct immolate_t: public warlock_spell_t
     const spell_data_t* dmg_spell = player -> find_spell( 157736 );
 
     can_havoc = true;
+    custom_snapshot = true; // Roaring Blaze reads the target's debuff
 
     base_tick_time = dmg_spell -> effectN( 1 ).period();
     dot_duration = dmg_spell -> duration();
@@ -5385,6 +5386,7 @@ struct shadowflame_t : public warlock_spell_t
     warlock_spell_t( "shadowflame", p, p -> talents.shadowflame )
   {
     hasted_ticks = tick_may_crit = true;
+    custom_snapshot = true; // Stacks of the target's debuff
 
     dot_duration = timespan_t::from_seconds( 8.0 );
     spell_power_mod.tick = data().effectN( 2 ).sp_coeff();
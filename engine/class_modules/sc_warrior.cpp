@@ -645,7 +645,7 @@ public:
 
     if ( !td )
     {
-      td = new warrior_td_t( target, const_cast<warrior_t&>( *this ) );
+      td = target_data.construct( target, const_cast<warrior_t&>( *this ) );
     }
     return td;
   }
@@ -12,6 +12,7 @@
 #include <string>
 #include <functional>
 #include <unordered_map>
+#include <mutex>
 #include <iostream>
 
 #include "data_definitions.hh"
@@ -1797,6 +1798,69 @@ public:
   }
 };
 
+/* Name keys for dbc_name_index_t. name_policy indexes the name as is (case sensitive),
+ * tokenized_name_policy the tokenized (lower case) name.
+ */
+struct name_policy
+{
+  template <typename T> static std::string key( const T& t )
+  { return t.name_cstr(); }
+  static std::string key( const char* name )
+  { return name; }
+};
+
+struct tokenized_name_policy
+{
+  template <typename T> static std::string key( const T& t )
+  { return util::tokenize_fn( t.name_cstr() ); }
+  static std::string key( const char* name )
+  {
+    std::string key = name;
+    util::tolower( key );
+    return key;
+  }
+};
+
+/* Hashed name -> data index, built lazily on first lookup (once per data set, thread safe).
+ * Entries sharing a name are kept in list order, so the first match of a linear scan is the
+ * first entry of the bucket.
+ */
+template <typename T, typename KeyPolicy = name_policy>
+class dbc_name_index_t
+{
+public:
+  typedef std::vector<T*> entries_t;
+
+private:
+#if SC_USE_PTR == 0
+  std::unordered_map<std::string, entries_t> idx[ 1 ];
+  std::once_flag once[ 1 ];
+#else
+  std::unordered_map<std::string, entries_t> idx[ 2 ];
+  std::once_flag once[ 2 ];
+#endif
+
+  void populate( bool ptr )
+  {
+    auto& index = idx[ maybe_ptr( ptr ) ];
+    for ( T* p = T::list( ptr ); p -> name_cstr(); ++p )
+    {
+      index[ KeyPolicy::key( *p ) ].push_back( p );
+    }
+  }
+
+public:
+  // Return all entries matching the name, in list order, or nullptr
+  const entries_t* get( bool ptr, const char* name )
+  {
+    std::call_once( once[ maybe_ptr( ptr ) ], [ this, ptr ]() { populate( ptr ); } );
+
+    const auto& index = idx[ maybe_ptr( ptr ) ];
+    auto it = index.find( KeyPolicy::key( name ) );
+    return it != index.end() ? &( it -> second ) : nullptr;
+  }
+};
+
 template <typename T, typename Filter, typename KeyPolicy = id_function_policy>
 class filtered_dbc_index_t
 {
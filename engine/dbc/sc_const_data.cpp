@@ -26,6 +26,9 @@ namespace { // ANONYMOUS namespace ==========================================
 dbc_index_t<spell_data_t> spell_data_index;
 dbc_index_t<spelleffect_data_t> spelleffect_data_index;
 dbc_index_t<talent_data_t> talent_data_index;
+dbc_name_index_t<spell_data_t> spell_name_index;
+dbc_name_index_t<talent_data_t> talent_name_index;
+dbc_name_index_t<talent_data_t, tokenized_name_policy> talent_tokenized_name_index;
 dbc_index_t<spellpower_data_t> power_data_index;
 ordered_dbc_index_t<artifact_power_rank_t> artifact_power_rank_data_index;
 
@@ -160,6 +163,18 @@ spell_mapping_reference_t<spell_data_t, unsigned> spell_categories_index(
     return 0U;
   }
 );
+
+// First talent of the given spec among talents sharing a name
+talent_data_t* find_talent_by_spec( const std::vector<talent_data_t*>* talents, specialization_e spec )
+{
+  if ( ! talents )
+    return nullptr;
+
+  auto it = range::find_if( *talents, [ spec ]( const talent_data_t* t ) {
+    return t -> specialization() == spec;
+  } );
+  return it != talents -> end() ? *it : nullptr;
+}
 } // ANONYMOUS namespace ====================================================
 
 int dbc::build_level( bool ptr )
@@ -1825,14 +1840,8 @@ spell_data_t* spell_data_t::find( unsigned spell_id, const char* confirmation, b
 
 spell_data_t* spell_data_t::find( const char* name, bool ptr )
 {
-  for ( spell_data_t* p = spell_data_t::list( ptr ); p -> name_cstr(); ++p )
-  {
-    if ( ! strcmp ( name, p -> name_cstr() ) )
-    {
-      return p;
-    }
-  }
-  return nullptr;
+  const auto spells = spell_name_index.get( ptr, name );
+  return spells ? spells -> front() : nullptr;
 }
 
 // Always returns non-NULL
@@ -1909,28 +1918,12 @@ talent_data_t* talent_data_t::find( unsigned id, const char* confirmation, bool
 
 talent_data_t* talent_data_t::find( const char* name_cstr, specialization_e spec, bool ptr )
 {
-  for ( talent_data_t* p = talent_data_t::list( ptr ); p -> name_cstr(); ++p )
-  {
-    if ( ! strcmp( name_cstr, p -> name_cstr() ) && p -> specialization() == spec )
-    {
-      return p;
-    }
-  }
-
-  return nullptr;
+  return find_talent_by_spec( talent_name_index.get( ptr, name_cstr ), spec );
 }
 
 talent_data_t* talent_data_t::find_tokenized( const char* name, specialization_e spec, bool ptr )
 {
-  for ( talent_data_t* p = talent_data_t::list( ptr ); p -> name_cstr(); ++p )
-  {
-    std::string tokenized_name = p -> name_cstr();
-    util::tokenize( tokenized_name );
-    if ( util::str_compare_ci( name, tokenized_name ) && p -> specialization() == spec )
-      return p;
-  }
-
-  return nullptr;
+  return find_talent_by_spec( talent_tokenized_name_index.get( ptr, name ), spec );
 }
 
 void spell_data_t::link( bool ptr )
@@ -746,16 +746,22 @@ player_t::player_t( sim_t*             s,
   active_during_iteration( false ),
   _mastery( spelleffect_data_t::nil() ),
   cache( this ),
+  cache_closure(),
+  cache_hooks( 0 ),
   regen_type( REGEN_STATIC ),
   last_regen( timespan_t::zero() ),
   regen_caches( CACHE_MAX ),
   dynamic_regen_pets( false ),
   visited_apls_( 0 ),
+  ready_evaluations( 0 ),
+  ready_evaluations_saved( 0 ),
   action_list_id_( 0 )
 {
   actor_index = sim -> actor_list.size();
   sim -> actor_list.push_back( this );
 
+  crn_stream.key = sim -> crn_key( name_str );
+
   if ( ! is_enemy() && ! is_pet() && type != HEALING_ENEMY )
   {
     artifact = artifact::player_artifact_data_t::create( this );
@@ -806,6 +812,7 @@ player_t::player_t( sim_t*             s,
   {
     cache.active = sim -> stat_cache != 0;
   }
+  cache.count = sim -> stat_cache_counters;
   if ( is_pet() ) current.skill = 1.0;
 
   resources.infinite_resource[ RESOURCE_HEALTH ] = true;
@@ -2473,7 +2480,7 @@ void player_t::init_assessors()
     proc_types pt = state -> proc_type();
     proc_types2 pt2 = state -> impact_proc_type2();
     if ( pt != PROC1_INVALID && pt2 != PROC2_INVALID )
-      action_callback_t::trigger( callbacks.procs[ pt ][ pt2 ], state -> action, state );
+      state -> action -> trigger_proc_callbacks( pt, pt2, state );
 
     return assessor::CONTINUE;
   } );
@@ -3692,6 +3699,80 @@ double player_t::composite_mastery_value() const
 
 #if defined(SC_USE_STAT_CACHE)
 
+namespace {
+
+// Stat cache dependency graph. Invalidating "from" also invalidates "to", optionally only when
+// the player's current value of "condition" is positive (e.g. attack power per strength).
+struct cache_dependency_t
+{
+  cache_e from, to;
+  double player_t::base_initial_current_t::* condition;
+};
+
+const cache_dependency_t cache_dependencies[] =
+{
+  { CACHE_STRENGTH,    CACHE_ATTACK_POWER,               &player_t::base_initial_current_t::attack_power_per_strength },
+  { CACHE_STRENGTH,    CACHE_PARRY,                      &player_t::base_initial_current_t::parry_per_strength },
+  { CACHE_AGILITY,     CACHE_ATTACK_POWER,               &player_t::base_initial_current_t::attack_power_per_agility },
+  { CACHE_AGILITY,     CACHE_DODGE,                      &player_t::base_initial_current_t::dodge_per_agility },
+  { CACHE_INTELLECT,   CACHE_SPELL_POWER,                &player_t::base_initial_current_t::spell_power_per_intellect },
+  { CACHE_ATTACK_HASTE, CACHE_ATTACK_SPEED,              nullptr },
+  { CACHE_SPELL_HASTE, CACHE_SPELL_SPEED,                nullptr },
+  { CACHE_BONUS_ARMOR, CACHE_ARMOR,                      nullptr },
+  { CACHE_EXP,         CACHE_ATTACK_EXP,                 nullptr },
+  { CACHE_EXP,         CACHE_SPELL_HIT,                  nullptr },
+  { CACHE_HIT,         CACHE_ATTACK_HIT,                 nullptr },
+  { CACHE_HIT,         CACHE_SPELL_HIT,                  nullptr },
+  { CACHE_CRIT_CHANCE, CACHE_ATTACK_CRIT_CHANCE,         nullptr },
+  { CACHE_CRIT_CHANCE, CACHE_SPELL_CRIT_CHANCE,          nullptr },
+  { CACHE_HASTE,       CACHE_ATTACK_HASTE,               nullptr },
+  { CACHE_HASTE,       CACHE_SPELL_HASTE,                nullptr },
+  { CACHE_SPEED,       CACHE_ATTACK_SPEED,               nullptr },
+  { CACHE_SPEED,       CACHE_SPELL_SPEED,                nullptr },
+  { CACHE_VERSATILITY, CACHE_DAMAGE_VERSATILITY,         nullptr },
+  { CACHE_VERSATILITY, CACHE_HEAL_VERSATILITY,           nullptr },
+  { CACHE_VERSATILITY, CACHE_MITIGATION_VERSATILITY,     nullptr },
+};
+
+// Aggregate caches hold no value of their own, they only fan out to their dependents
+const uint64_t aggregate_caches = ( uint64_t( 1 ) << CACHE_EXP ) | ( uint64_t( 1 ) << CACHE_HIT ) |
+                                  ( uint64_t( 1 ) << CACHE_CRIT_CHANCE ) | ( uint64_t( 1 ) << CACHE_HASTE ) |
+                                  ( uint64_t( 1 ) << CACHE_SPEED ) | ( uint64_t( 1 ) << CACHE_VERSATILITY );
+
+} // unnamed namespace
+
+// player_t::init_cache_closure =============================================
+
+/* Compute the transitive closure of the dependency table for each cache, given the current stat
+ * conversions of the player. The closure of a cache includes the cache itself.
+ */
+void player_t::init_cache_closure()
+{
+  for ( size_t i = 0; i < cache_closure.size(); i++ )
+    cache_closure[ i ] = uint64_t( 1 ) << i;
+
+  bool changed = true;
+  while ( changed )
+  {
+    changed = false;
+    for ( const auto& dep : cache_dependencies )
+    {
+      if ( dep.condition != nullptr && current.*( dep.condition ) <= 0 )
+        continue;
+
+      uint64_t closure = cache_closure[ dep.from ] | cache_closure[ dep.to ];
+      if ( closure != cache_closure[ dep.from ] )
+      {
+        cache_closure[ dep.from ] = closure;
+        changed = true;
+      }
+    }
+  }
+
+  for ( auto& closure : cache_closure )
+    closure &= ~aggregate_caches;
+}
+
 // player_t::invalidate_cache ===============================================
 
 void player_t::invalidate_cache( cache_e c )
@@ -3700,70 +3781,23 @@ void player_t::invalidate_cache( cache_e c )
 
   if ( sim -> debug ) sim -> out_debug.printf( "%s invalidates %s", name(), util::cache_type_string( c ) );
 
-  // Special linked invalidations
-  switch ( c )
-  {
-    case CACHE_STRENGTH:
-      if ( current.attack_power_per_strength > 0 )
-        invalidate_cache( CACHE_ATTACK_POWER );
-      if ( current.parry_per_strength > 0 )
-        invalidate_cache( CACHE_PARRY );
-      break;
-    case CACHE_AGILITY:
-      if ( current.attack_power_per_agility > 0 )
-        invalidate_cache( CACHE_ATTACK_POWER );
-      if ( current.dodge_per_agility > 0 )
-        invalidate_cache( CACHE_DODGE );
-      break;
-    case CACHE_INTELLECT:
-      if ( current.spell_power_per_intellect > 0 )
-        invalidate_cache( CACHE_SPELL_POWER );
-      break;
-    case CACHE_ATTACK_HASTE:
-      invalidate_cache( CACHE_ATTACK_SPEED );
-      break;
-    case CACHE_SPELL_HASTE:
-      invalidate_cache( CACHE_SPELL_SPEED );
-      break;
-    case CACHE_BONUS_ARMOR:
-      invalidate_cache( CACHE_ARMOR );
-    default: break;
-  }
+  uint64_t closure = cache_closure[ c ];
+  cache.invalidate( closure );
 
-  // Normal invalidation of the corresponding Cache
-  switch ( c )
+  // Dependents that class modules hook still go through invalidate_cache()
+  uint64_t hooked = closure & cache_hooks & ~( uint64_t( 1 ) << c );
+  for ( unsigned i = 0; hooked; ++i, hooked >>= 1 )
   {
-    case CACHE_EXP:
-      invalidate_cache( CACHE_ATTACK_EXP );
-      invalidate_cache( CACHE_SPELL_HIT  );
-      break;
-    case CACHE_HIT:
-      invalidate_cache( CACHE_ATTACK_HIT );
-      invalidate_cache( CACHE_SPELL_HIT  );
-      break;
-    case CACHE_CRIT_CHANCE:
-      invalidate_cache( CACHE_ATTACK_CRIT_CHANCE );
-      invalidate_cache( CACHE_SPELL_CRIT_CHANCE  );
-      break;
-    case CACHE_HASTE:
-      invalidate_cache( CACHE_ATTACK_HASTE );
-      invalidate_cache( CACHE_SPELL_HASTE  );
-      break;
-    case CACHE_SPEED:
-      invalidate_cache( CACHE_ATTACK_SPEED );
-      invalidate_cache( CACHE_SPELL_SPEED  );
-      break;
-    case CACHE_VERSATILITY:
-      invalidate_cache( CACHE_DAMAGE_VERSATILITY );
-      invalidate_cache( CACHE_HEAL_VERSATILITY );
-      invalidate_cache( CACHE_MITIGATION_VERSATILITY );
-      break;
-    default:
-      cache.invalidate( c );
-      break;
+    if ( hooked & 1 )
+      invalidate_cache( static_cast<cache_e>( i ) );
   }
 }
 
+#else
+
+void player_t::init_cache_closure()
+{ }
+
 #endif
 
 void player_t::sequence_add_wait( const timespan_t& amount, const timespan_t& ts )
@@ -4155,6 +4189,23 @@ void merge( player_t& left, player_t& right )
 
 } } // namespace {anonymous}::buff_merge
 
+namespace {
+
+// Actor object lists are built in the same order in every sim thread, so the entry at the same
+// position of the other actor is normally the one to merge with. Fall back to a lookup otherwise.
+template <typename T, typename F>
+T* merge_partner( const std::vector<T*>& other_list, size_t i, const std::string& name, F find )
+{
+  if ( i < other_list.size() && other_list[ i ] -> name_str == name )
+  {
+    return other_list[ i ];
+  }
+
+  return find( name );
+}
+
+} // unnamed namespace
+
 void player_t::merge( player_t& other )
 {
   collected_data.merge( other.collected_data );
@@ -4165,13 +4216,17 @@ void player_t::merge( player_t& other )
     iteration_resource_gained[ i ] += other.iteration_resource_gained[ i ];
   }
 
+  ready_evaluations += other.ready_evaluations;
+  ready_evaluations_saved += other.ready_evaluations_saved;
+  cache.merge( other.cache );
+
   buff_merge::merge( *this, other );
 
   // Procs
   for ( size_t i = 0; i < proc_list.size(); ++i )
   {
     proc_t& proc = *proc_list[ i ];
-    if ( proc_t* other_proc = other.find_proc( proc.name_str ) )
+    if ( proc_t* other_proc = merge_partner( other.proc_list, i, proc.name_str, [ &other ]( const std::string& n ) { return other.find_proc( n ); } ) )
       proc.merge( *other_proc );
     else
     {
@@ -4185,7 +4240,7 @@ void player_t::merge( player_t& other )
   for ( size_t i = 0; i < gain_list.size(); ++i )
   {
     gain_t& gain = *gain_list[ i ];
-    if ( gain_t* other_gain = other.find_gain( gain.name_str ) )
+    if ( gain_t* other_gain = merge_partner( other.gain_list, i, gain.name_str, [ &other ]( const std::string& n ) { return other.find_gain( n ); } ) )
       gain.merge( *other_gain );
     else
     {
@@ -4199,7 +4254,7 @@ void player_t::merge( player_t& other )
   for ( size_t i = 0; i < stats_list.size(); ++i )
   {
     stats_t& stats = *stats_list[ i ];
-    if ( stats_t* other_stats = other.find_stats( stats.name_str ) )
+    if ( stats_t* other_stats = merge_partner( other.stats_list, i, stats.name_str, [ &other ]( const std::string& n ) { return other.find_stats( n ); } ) )
       stats.merge( *other_stats );
     else
     {
@@ -4213,7 +4268,7 @@ void player_t::merge( player_t& other )
   for ( size_t i = 0; i < uptime_list.size(); ++i )
   {
     uptime_t& uptime = *uptime_list[ i ];
-    if ( uptime_t* other_uptime = other.find_uptime( uptime.name_str ) )
+    if ( uptime_t* other_uptime = merge_partner( other.uptime_list, i, uptime.name_str, [ &other ]( const std::string& n ) { return other.find_uptime( n ); } ) )
       uptime.merge( *other_uptime );
     else
     {
@@ -4227,7 +4282,7 @@ void player_t::merge( player_t& other )
   for ( size_t i = 0; i < benefit_list.size(); ++i )
   {
     benefit_t& benefit = *benefit_list[ i ];
-    if ( benefit_t* other_benefit = other.find_benefit( benefit.name_str ) )
+    if ( benefit_t* other_benefit = merge_partner( other.benefit_list, i, benefit.name_str, [ &other ]( const std::string& n ) { return other.find_benefit( n ); } ) )
       benefit.merge( *other_benefit );
     else
     {
@@ -4241,7 +4296,7 @@ void player_t::merge( player_t& other )
   for ( size_t i = 0; i < sample_data_list.size(); ++i )
   {
     luxurious_sample_data_t& sd = *sample_data_list[ i ];
-    if ( luxurious_sample_data_t* other_sd = other.find_sample_data( sd.name_str ) )
+    if ( luxurious_sample_data_t* other_sd = merge_partner( other.sample_data_list, i, sd.name_str, [ &other ]( const std::string& n ) { return other.find_sample_data( n ); } ) )
       sd.merge( *other_sd );
     else
     {
@@ -4289,6 +4344,7 @@ void player_t::reset()
 
   // Reset current stats to initial stats
   current = initial;
+  init_cache_closure();
 
   current.sleeping = true;
 
@@ -9178,6 +9234,9 @@ expr_t* player_t::create_expression( action_t* a,
 
       double evaluate() override
       { return var_ -> current_value_; }
+
+      bool dependencies( expr_dependencies_t& deps ) override
+      { deps.add( var_ -> current_value_ ); return true; }
     };
 
     variable_expr_t* expr = new variable_expr_t( this, splits[ 1 ] );
@@ -9698,6 +9757,27 @@ expr_t* player_t::create_resource_expression( const std::string& name_str )
 
     resource_expr_t( const std::string& n, player_t& p, resource_e r ) :
       player_expr_t( n, p ), rt( r ) {}
+
+    // Current and maximum amount of the resource. These are written directly in many places, so
+    // they are tracked by value.
+    bool resource_dependencies( expr_dependencies_t& deps ) const
+    {
+      deps.add( player.resources.current[ rt ] );
+      deps.add( player.resources.max[ rt ] );
+      return true;
+    }
+  };
+
+  struct resource_amount_expr_t : public resource_expr_t
+  {
+    const double& amount;
+
+    resource_amount_expr_t( const std::string& n, player_t& p, resource_e r, const double& a ) :
+      resource_expr_t( n, p, r ), amount( a ) {}
+    virtual double evaluate() override
+    { return amount; }
+    bool dependencies( expr_dependencies_t& deps ) override
+    { deps.add( amount ); return true; }
   };
 
   std::vector<std::string> splits = util::string_split( name_str, "." );
@@ -9709,7 +9789,7 @@ expr_t* player_t::create_resource_expression( const std::string& name_str )
     return 0;
 
   if ( splits.size() == 1 )
-    return make_ref_expr( name_str, resources.current[ r ] );
+    return new resource_amount_expr_t( name_str, *this, r, resources.current[ r ] );
 
   if ( splits.size() == 2 )
   {
@@ -9721,6 +9801,8 @@ expr_t* player_t::create_resource_expression( const std::string& name_str )
           resource_expr_t( n, p, r ) {}
         virtual double evaluate() override
         { return player.resources.max[ rt ] - player.resources.current[ rt ]; }
+        bool dependencies( expr_dependencies_t& deps ) override
+        { return resource_dependencies( deps ); }
       };
       return new resource_deficit_expr_t( name_str, *this, r );
     }
@@ -9739,13 +9821,15 @@ expr_t* player_t::create_resource_expression( const std::string& name_str )
             resource_expr_t( n, p, r ) {}
           virtual double evaluate() override
           { return player.resources.pct( rt ) * 100.0; }
+          bool dependencies( expr_dependencies_t& deps ) override
+          { return resource_dependencies( deps ); }
         };
         return new resource_pct_expr_t( name_str, *this, r  );
       }
     }
 
     else if ( splits[ 1 ] == "max" )
-      return make_ref_expr( name_str, resources.max[ r ] );
+      return new resource_amount_expr_t( name_str, *this, r, resources.max[ r ] );
 
     else if ( splits[ 1 ] == "max_nonproc" )
       return make_ref_expr( name_str, collected_data.buffed_stats_snapshot.resource[ r ] );
@@ -10701,6 +10785,46 @@ scaling_metric_data_t player_t::scaling_for_metric( scale_metric_e metric ) cons
   }
 }
 
+// Value of scaling_for_metric() in the iteration that just ended. NaN if the sample data does not
+// retain per-iteration samples.
+double player_t::iteration_scaling_for_metric( scale_metric_e metric ) const
+{
+  const player_t* q = nullptr;
+  if ( ! sim -> scaling -> scale_over_player.empty() )
+    q = sim -> find_player( sim -> scaling -> scale_over_player );
+  if ( !q )
+    q = this;
+
+  auto last = []( const extended_sample_data_t& sd ) {
+    return sd.data().empty() ? std::numeric_limits<double>::quiet_NaN() : sd.data().back();
+  };
+
+  const auto& cd = q -> collected_data;
+  switch ( metric )
+  {
+    case SCALE_METRIC_DPS:        return last( cd.dps );
+    case SCALE_METRIC_DPSE:       return last( cd.dpse );
+    case SCALE_METRIC_HPS:        return last( cd.hps );
+    case SCALE_METRIC_HPSE:       return last( cd.hpse );
+    case SCALE_METRIC_APS:        return last( cd.aps );
+    case SCALE_METRIC_DPSP:       return last( cd.prioritydps );
+    case SCALE_METRIC_HAPS:       return last( cd.hps ) + last( cd.aps );
+    case SCALE_METRIC_DTPS:       return last( cd.dtps );
+    case SCALE_METRIC_DMG_TAKEN:  return last( cd.dmg_taken );
+    case SCALE_METRIC_HTPS:       return last( cd.htps );
+    case SCALE_METRIC_TMI:        return last( cd.theck_meloree_index );
+    case SCALE_METRIC_ETMI:       return last( cd.effective_theck_meloree_index );
+    case SCALE_METRIC_DEATHS:     return last( cd.deaths );
+    default:
+      if ( q -> primary_role() == ROLE_TANK )
+        return last( cd.dtps );
+      else if ( q -> primary_role() == ROLE_HEAL )
+        return iteration_scaling_for_metric( SCALE_METRIC_HAPS );
+      else
+        return last( cd.dps );
+  }
+}
+
 // Change the player position ( fron/back, etc. ) and update attack hit table
 
 void player_t::change_position( position_e new_pos )
@@ -10717,30 +10841,61 @@ void player_stat_cache_t::invalidate_all()
 {
   if ( ! active ) return;
 
-  range::fill( valid, false );
-  range::fill( spell_power_valid, false );
-  range::fill( player_mult_valid, false );
-  range::fill( player_heal_mult_valid, false );
+  valid = 0;
+  spell_power_valid = player_mult_valid = player_heal_mult_valid = 0;
 }
 
-/* Invalidate ALL stats
+/* Invalidate a single stat
  */
 void player_stat_cache_t::invalidate( cache_e c )
 {
-  switch ( c )
+  invalidate( uint64_t( 1 ) << c );
+}
+
+/* Invalidate a set of stats in one go, the mask holding a bit for each cache_e
+ */
+void player_stat_cache_t::invalidate( uint64_t mask )
+{
+  if ( count )
   {
-    case CACHE_SPELL_POWER:
-      range::fill( spell_power_valid, false );
-      break;
-    case CACHE_PLAYER_DAMAGE_MULTIPLIER:
-      range::fill( player_mult_valid, false );
-      break;
-    case CACHE_PLAYER_HEAL_MULTIPLIER:
-      range::fill( player_heal_mult_valid, false );
-      break;
-    default:
-      valid[ c ] = false;
-      break;
+    // Count the values actually dropped from the cache
+    uint64_t dropped = valid & mask;
+    if ( spell_power_valid )
+      dropped |= mask & ( uint64_t( 1 ) << CACHE_SPELL_POWER );
+    if ( player_mult_valid )
+      dropped |= mask & ( uint64_t( 1 ) << CACHE_PLAYER_DAMAGE_MULTIPLIER );
+    if ( player_heal_mult_valid )
+      dropped |= mask & ( uint64_t( 1 ) << CACHE_PLAYER_HEAL_MULTIPLIER );
+    for ( size_t i = 0; dropped; ++i, dropped >>= 1 )
+    {
+      if ( dropped & 1 )
+        counters[ i ].invalidations++;
+    }
+  }
+
+  valid &= ~mask;
+
+  // Per-school caches
+  if ( mask & ( uint64_t( 1 ) << CACHE_SPELL_POWER ) )
+    spell_power_valid = 0;
+  if ( mask & ( uint64_t( 1 ) << CACHE_PLAYER_DAMAGE_MULTIPLIER ) )
+    player_mult_valid = 0;
+  if ( mask & ( uint64_t( 1 ) << CACHE_PLAYER_HEAL_MULTIPLIER ) )
+    player_heal_mult_valid = 0;
+}
+
+void player_stat_cache_t::reset_counters()
+{
+  range::fill( counters, counter_t { 0, 0, 0 } );
+}
+
+void player_stat_cache_t::merge( const player_stat_cache_t& other )
+{
+  for ( size_t i = 0; i < counters.size(); i++ )
+  {
+    counters[ i ].hits += other.counters[ i ].hits;
+    counters[ i ].misses += other.counters[ i ].misses;
+    counters[ i ].invalidations += other.counters[ i ].invalidations;
   }
 }
 
@@ -10765,9 +10920,9 @@ double player_stat_cache_t::get_attribute( attribute_e a ) const
 
 double player_stat_cache_t::strength() const
 {
-  if ( ! active || ! valid[ CACHE_STRENGTH ] )
+  if ( ! active || ! check( CACHE_STRENGTH ) )
   {
-    valid[ CACHE_STRENGTH ] = true;
+    validate( CACHE_STRENGTH );
     _strength = player -> strength();
   }
   else assert( _strength == player -> strength() );
@@ -10778,9 +10933,9 @@ double player_stat_cache_t::strength() const
 
 double player_stat_cache_t::agility() const
 {
-  if ( ! active || ! valid[ CACHE_AGILITY ] )
+  if ( ! active || ! check( CACHE_AGILITY ) )
   {
-    valid[ CACHE_AGILITY ] = true;
+    validate( CACHE_AGILITY );
     _agility = player -> agility();
   }
   else assert( _agility == player -> agility() );
@@ -10791,9 +10946,9 @@ double player_stat_cache_t::agility() const
 
 double player_stat_cache_t::stamina() const
 {
-  if ( ! active || ! valid[ CACHE_STAMINA ] )
+  if ( ! active || ! check( CACHE_STAMINA ) )
   {
-    valid[ CACHE_STAMINA ] = true;
+    validate( CACHE_STAMINA );
     _stamina = player -> stamina();
   }
   else assert( _stamina == player -> stamina() );
@@ -10804,9 +10959,9 @@ double player_stat_cache_t::stamina() const
 
 double player_stat_cache_t::intellect() const
 {
-  if ( ! active || ! valid[ CACHE_INTELLECT ] )
+  if ( ! active || ! check( CACHE_INTELLECT ) )
   {
-    valid[ CACHE_INTELLECT ] = true;
+    validate( CACHE_INTELLECT );
     _intellect = player -> intellect();
   }
   else assert( _intellect == player -> intellect() );
@@ -10817,9 +10972,9 @@ double player_stat_cache_t::intellect() const
 
 double player_stat_cache_t::spirit() const
 {
-  if ( ! active || ! valid[ CACHE_SPIRIT ] )
+  if ( ! active || ! check( CACHE_SPIRIT ) )
   {
-    valid[ CACHE_SPIRIT ] = true;
+    validate( CACHE_SPIRIT );
     _spirit = player -> spirit();
   }
   else assert( _spirit == player -> spirit() );
@@ -10830,9 +10985,9 @@ double player_stat_cache_t::spirit() const
 
 double player_stat_cache_t::spell_power( school_e s ) const
 {
-  if ( ! active || ! spell_power_valid[ s ] )
+  if ( ! active || ! check( spell_power_valid, CACHE_SPELL_POWER, s ) )
   {
-    spell_power_valid[ s ] = true;
+    validate( spell_power_valid, s );
     _spell_power[ s ] = player -> composite_spell_power( s );
   }
   else assert( _spell_power[ s ] == player -> composite_spell_power( s ) );
@@ -10843,9 +10998,9 @@ double player_stat_cache_t::spell_power( school_e s ) const
 
 double player_stat_cache_t::attack_power() const
 {
-  if ( ! active || ! valid[ CACHE_ATTACK_POWER ] )
+  if ( ! active || ! check( CACHE_ATTACK_POWER ) )
   {
-    valid[ CACHE_ATTACK_POWER ] = true;
+    validate( CACHE_ATTACK_POWER );
     _attack_power = player -> composite_melee_attack_power();
   }
   else assert( _attack_power == player -> composite_melee_attack_power() );
@@ -10856,9 +11011,9 @@ double player_stat_cache_t::attack_power() const
 
 double player_stat_cache_t::attack_expertise() const
 {
-  if ( ! active || ! valid[ CACHE_ATTACK_EXP ] )
+  if ( ! active || ! check( CACHE_ATTACK_EXP ) )
   {
-    valid[ CACHE_ATTACK_EXP ] = true;
+    validate( CACHE_ATTACK_EXP );
     _attack_expertise = player -> composite_melee_expertise();
   }
   else assert( _attack_expertise == player -> composite_melee_expertise() );
@@ -10869,9 +11024,9 @@ double player_stat_cache_t::attack_expertise() const
 
 double player_stat_cache_t::attack_hit() const
 {
-  if ( ! active || ! valid[ CACHE_ATTACK_HIT ] )
+  if ( ! active || ! check( CACHE_ATTACK_HIT ) )
   {
-    valid[ CACHE_ATTACK_HIT ] = true;
+    validate( CACHE_ATTACK_HIT );
     _attack_hit = player -> composite_melee_hit();
   }
   else
@@ -10889,9 +11044,9 @@ double player_stat_cache_t::attack_hit() const
 
 double player_stat_cache_t::attack_crit_chance() const
 {
-  if ( ! active || ! valid[ CACHE_ATTACK_CRIT_CHANCE ] )
+  if ( ! active || ! check( CACHE_ATTACK_CRIT_CHANCE ) )
   {
-    valid[ CACHE_ATTACK_CRIT_CHANCE ] = true;
+    validate( CACHE_ATTACK_CRIT_CHANCE );
     _attack_crit_chance = player -> composite_melee_crit_chance();
   }
   else assert( _attack_crit_chance == player -> composite_melee_crit_chance() );
@@ -10902,9 +11057,9 @@ double player_stat_cache_t::attack_crit_chance() const
 
 double player_stat_cache_t::attack_haste() const
 {
-  if ( ! active || ! valid[ CACHE_ATTACK_HASTE ] )
+  if ( ! active || ! check( CACHE_ATTACK_HASTE ) )
   {
-    valid[ CACHE_ATTACK_HASTE ] = true;
+    validate( CACHE_ATTACK_HASTE );
     _attack_haste = player -> composite_melee_haste();
   }
   else assert( _attack_haste == player -> composite_melee_haste() );
@@ -10915,9 +11070,9 @@ double player_stat_cache_t::attack_haste() const
 
 double player_stat_cache_t::attack_speed() const
 {
-  if ( ! active || ! valid[ CACHE_ATTACK_SPEED ] )
+  if ( ! active || ! check( CACHE_ATTACK_SPEED ) )
   {
-    valid[ CACHE_ATTACK_SPEED ] = true;
+    validate( CACHE_ATTACK_SPEED );
     _attack_speed = player -> composite_melee_speed();
   }
   else assert( _attack_speed == player -> composite_melee_speed() );
@@ -10928,9 +11083,9 @@ double player_stat_cache_t::attack_speed() const
 
 double player_stat_cache_t::spell_hit() const
 {
-  if ( ! active || ! valid[ CACHE_SPELL_HIT ] )
+  if ( ! active || ! check( CACHE_SPELL_HIT ) )
   {
-    valid[ CACHE_SPELL_HIT ] = true;
+    validate( CACHE_SPELL_HIT );
     _spell_hit = player -> composite_spell_hit();
   }
   else assert( _spell_hit == player -> composite_spell_hit() );
@@ -10941,9 +11096,9 @@ double player_stat_cache_t::spell_hit() const
 
 double player_stat_cache_t::spell_crit_chance() const
 {
-  if ( ! active || ! valid[ CACHE_SPELL_CRIT_CHANCE ] )
+  if ( ! active || ! check( CACHE_SPELL_CRIT_CHANCE ) )
   {
-    valid[ CACHE_SPELL_CRIT_CHANCE ] = true;
+    validate( CACHE_SPELL_CRIT_CHANCE );
     _spell_crit_chance = player -> composite_spell_crit_chance();
   }
   else assert( _spell_crit_chance == player -> composite_spell_crit_chance() );
@@ -10954,9 +11109,9 @@ double player_stat_cache_t::spell_crit_chance() const
 
 double player_stat_cache_t::spell_haste() const
 {
-  if ( ! active || ! valid[ CACHE_SPELL_HASTE ] )
+  if ( ! active || ! check( CACHE_SPELL_HASTE ) )
   {
-    valid[ CACHE_SPELL_HASTE ] = true;
+    validate( CACHE_SPELL_HASTE );
     _spell_haste = player -> composite_spell_haste();
   }
   else assert( _spell_haste == player -> composite_spell_haste() );
@@ -10967,9 +11122,9 @@ double player_stat_cache_t::spell_haste() const
 
 double player_stat_cache_t::spell_speed() const
 {
-  if ( ! active || ! valid[ CACHE_SPELL_SPEED ] )
+  if ( ! active || ! check( CACHE_SPELL_SPEED ) )
   {
-    valid[ CACHE_SPELL_SPEED ] = true;
+    validate( CACHE_SPELL_SPEED );
     _spell_speed = player -> composite_spell_speed();
   }
   else assert( _spell_speed == player -> composite_spell_speed() );
@@ -10978,9 +11133,9 @@ double player_stat_cache_t::spell_speed() const
 
 double player_stat_cache_t::dodge() const
 {
-  if ( ! active || ! valid[ CACHE_DODGE ] )
+  if ( ! active || ! check( CACHE_DODGE ) )
   {
-    valid[ CACHE_DODGE ] = true;
+    validate( CACHE_DODGE );
     _dodge = player -> composite_dodge();
   }
   else assert( _dodge == player -> composite_dodge() );
@@ -10989,9 +11144,9 @@ double player_stat_cache_t::dodge() const
 
 double player_stat_cache_t::parry() const
 {
-  if ( ! active || ! valid[ CACHE_PARRY ] )
+  if ( ! active || ! check( CACHE_PARRY ) )
   {
-    valid[ CACHE_PARRY ] = true;
+    validate( CACHE_PARRY );
     _parry = player -> composite_parry();
   }
   else assert( _parry == player -> composite_parry() );
@@ -11000,9 +11155,9 @@ double player_stat_cache_t::parry() const
 
 double player_stat_cache_t::block() const
 {
-  if ( ! active || ! valid[ CACHE_BLOCK ] )
+  if ( ! active || ! check( CACHE_BLOCK ) )
   {
-    valid[ CACHE_BLOCK ] = true;
+    validate( CACHE_BLOCK );
     _block = player -> composite_block();
   }
   else assert( _block == player -> composite_block() );
@@ -11011,9 +11166,9 @@ double player_stat_cache_t::block() const
 
 double player_stat_cache_t::crit_block() const
 {
-  if ( ! active || ! valid[ CACHE_CRIT_BLOCK ] )
+  if ( ! active || ! check( CACHE_CRIT_BLOCK ) )
   {
-    valid[ CACHE_CRIT_BLOCK ] = true;
+    validate( CACHE_CRIT_BLOCK );
     _crit_block = player -> composite_crit_block();
   }
   else assert( _crit_block == player -> composite_crit_block() );
@@ -11022,9 +11177,9 @@ double player_stat_cache_t::crit_block() const
 
 double player_stat_cache_t::crit_avoidance() const
 {
-  if ( ! active || ! valid[ CACHE_CRIT_AVOIDANCE ] )
+  if ( ! active || ! check( CACHE_CRIT_AVOIDANCE ) )
   {
-    valid[ CACHE_CRIT_AVOIDANCE ] = true;
+    validate( CACHE_CRIT_AVOIDANCE );
     _crit_avoidance = player -> composite_crit_avoidance();
   }
   else assert( _crit_avoidance == player -> composite_crit_avoidance() );
@@ -11033,9 +11188,9 @@ double player_stat_cache_t::crit_avoidance() const
 
 double player_stat_cache_t::miss() const
 {
-  if ( ! active || ! valid[ CACHE_MISS ] )
+  if ( ! active || ! check( CACHE_MISS ) )
   {
-    valid[ CACHE_MISS ] = true;
+    validate( CACHE_MISS );
     _miss = player -> composite_miss();
   }
   else assert( _miss == player -> composite_miss() );
@@ -11044,9 +11199,9 @@ double player_stat_cache_t::miss() const
 
 double player_stat_cache_t::armor() const
 {
-  if ( ! active || ! valid[ CACHE_ARMOR ] || ! valid[ CACHE_BONUS_ARMOR ] )
+  if ( ! active || ! check( CACHE_ARMOR ) )
   {
-    valid[ CACHE_ARMOR ] = true;
+    validate( CACHE_ARMOR );
     _armor = player -> composite_armor();
   }
   else assert( _armor == player -> composite_armor() );
@@ -11055,9 +11210,9 @@ double player_stat_cache_t::armor() const
 
 double player_stat_cache_t::mastery() const
 {
-  if ( ! active || ! valid[ CACHE_MASTERY ] )
+  if ( ! active || ! check( CACHE_MASTERY ) )
   {
-    valid[ CACHE_MASTERY ] = true;
+    validate( CACHE_MASTERY );
     _mastery = player -> composite_mastery();
     _mastery_value = player -> composite_mastery_value();
   }
@@ -11071,9 +11226,9 @@ double player_stat_cache_t::mastery() const
  */
 double player_stat_cache_t::mastery_value() const
 {
-  if ( ! active || ! valid[ CACHE_MASTERY ] )
+  if ( ! active || ! check( CACHE_MASTERY ) )
   {
-    valid[ CACHE_MASTERY ] = true;
+    validate( CACHE_MASTERY );
     _mastery = player -> composite_mastery();
     _mastery_value = player -> composite_mastery_value();
   }
@@ -11083,9 +11238,9 @@ double player_stat_cache_t::mastery_value() const
 
 double player_stat_cache_t::bonus_armor() const
 {
-  if ( ! active || ! valid[ CACHE_BONUS_ARMOR ] )
+  if ( ! active || ! check( CACHE_BONUS_ARMOR ) )
   {
-    valid[ CACHE_BONUS_ARMOR ] = true;
+    validate( CACHE_BONUS_ARMOR );
     _bonus_armor = player -> composite_bonus_armor();
   }
   else assert( _bonus_armor == player -> composite_bonus_armor() );
@@ -11094,9 +11249,9 @@ double player_stat_cache_t::bonus_armor() const
 
 double player_stat_cache_t::damage_versatility() const
 {
-  if ( ! active || ! valid[ CACHE_DAMAGE_VERSATILITY ] )
+  if ( ! active || ! check( CACHE_DAMAGE_VERSATILITY ) )
   {
-    valid[ CACHE_DAMAGE_VERSATILITY ] = true;
+    validate( CACHE_DAMAGE_VERSATILITY );
     _damage_versatility = player -> composite_damage_versatility();
   }
   else assert( _damage_versatility == player -> composite_damage_versatility() );
@@ -11105,9 +11260,9 @@ double player_stat_cache_t::damage_versatility() const
 
 double player_stat_cache_t::heal_versatility() const
 {
-  if ( ! active || ! valid[ CACHE_HEAL_VERSATILITY ] )
+  if ( ! active || ! check( CACHE_HEAL_VERSATILITY ) )
   {
-    valid[ CACHE_HEAL_VERSATILITY ] = true;
+    validate( CACHE_HEAL_VERSATILITY );
     _heal_versatility = player -> composite_heal_versatility();
   }
   else assert( _heal_versatility == player -> composite_heal_versatility() );
@@ -11116,9 +11271,9 @@ double player_stat_cache_t::heal_versatility() const
 
 double player_stat_cache_t::mitigation_versatility() const
 {
-  if ( ! active || ! valid[ CACHE_MITIGATION_VERSATILITY ] )
+  if ( ! active || ! check( CACHE_MITIGATION_VERSATILITY ) )
   {
-    valid[ CACHE_MITIGATION_VERSATILITY ] = true;
+    validate( CACHE_MITIGATION_VERSATILITY );
     _mitigation_versatility = player -> composite_mitigation_versatility();
   }
   else assert( _mitigation_versatility == player -> composite_mitigation_versatility() );
@@ -11127,9 +11282,9 @@ double player_stat_cache_t::mitigation_versatility() const
 
 double player_stat_cache_t::leech() const
 {
-  if ( ! active || ! valid[ CACHE_LEECH ] )
+  if ( ! active || ! check( CACHE_LEECH ) )
   {
-    valid[ CACHE_LEECH ] = true;
+    validate( CACHE_LEECH );
     _leech = player -> composite_leech();
   }
   else assert( _leech == player -> composite_leech() );
@@ -11138,9 +11293,9 @@ double player_stat_cache_t::leech() const
 
 double player_stat_cache_t::run_speed() const
 {
-  if ( !active || !valid[ CACHE_RUN_SPEED ] )
+  if ( !active || !check( CACHE_RUN_SPEED ) )
   {
-    valid[ CACHE_RUN_SPEED ] = true;
+    validate( CACHE_RUN_SPEED );
     _run_speed = player -> composite_movement_speed();
   }
   else assert( _run_speed == player -> composite_movement_speed() );
@@ -11149,9 +11304,9 @@ double player_stat_cache_t::run_speed() const
 
 double player_stat_cache_t::avoidance() const
 {
-  if ( !active || !valid[ CACHE_AVOIDANCE ] )
+  if ( !active || !check( CACHE_AVOIDANCE ) )
   {
-    valid[ CACHE_AVOIDANCE ] = true;
+    validate( CACHE_AVOIDANCE );
     _avoidance = player -> composite_avoidance();
   }
   else assert( _avoidance == player -> composite_avoidance() );
@@ -11162,9 +11317,9 @@ double player_stat_cache_t::avoidance() const
 
 double player_stat_cache_t::player_multiplier( school_e s ) const
 {
-  if ( ! active || ! player_mult_valid[ s ] )
+  if ( ! active || ! check( player_mult_valid, CACHE_PLAYER_DAMAGE_MULTIPLIER, s ) )
   {
-    player_mult_valid[ s ] = true;
+    validate( player_mult_valid, s );
     _player_mult[ s ] = player -> composite_player_multiplier( s );
   }
   else assert( _player_mult[ s ] == player -> composite_player_multiplier( s ) );
@@ -11177,9 +11332,9 @@ double player_stat_cache_t::player_heal_multiplier( const action_state_t* s ) co
 {
   school_e sch = s -> action -> get_school();
 
-  if ( ! active || ! player_heal_mult_valid[ sch ] )
+  if ( ! active || ! check( player_heal_mult_valid, CACHE_PLAYER_HEAL_MULTIPLIER, sch ) )
   {
-    player_heal_mult_valid[ sch ] = true;
+    validate( player_heal_mult_valid, sch );
     _player_heal_mult[ sch ] = player -> composite_player_heal_multiplier( s );
   }
   else assert( _player_heal_mult[ sch ] == player -> composite_player_heal_multiplier( s ) );
@@ -11385,6 +11540,19 @@ player_collected_data_t::player_collected_data_t( const player_t* player ) :
     resource_lost.resize( RESOURCE_HEALTH + 1 );
     resource_gained.resize( RESOURCE_HEALTH + 1 );
   }
+
+  if ( player -> sim -> streaming_statistics )
+  {
+    for ( auto sd : { &fight_length, &waiting_time, &pooling_time, &executed_foreground_actions,
+                      &dmg, &compound_dmg, &prioritydps, &dps, &dpse, &dtps, &dmg_taken,
+                      &heal, &compound_heal, &hps, &hpse, &htps, &heal_taken,
+                      &absorb, &compound_absorb, &aps, &atps, &absorb_taken,
+                      &deaths, &theck_meloree_index, &effective_theck_meloree_index,
+                      &max_spike_amount, &target_metric } )
+    {
+      sd -> change_streaming( true );
+    }
+  }
 }
 
 void player_collected_data_t::reserve_memory( const player_t& p )
@@ -11426,6 +11594,8 @@ void player_collected_data_t::merge( const player_collected_data_t& other )
 
   total_iterations += other.total_iterations;
 
+  crn_scaling_metric.merge( other.crn_scaling_metric );
+
   fight_length.merge( other.fight_length );
   waiting_time.merge( other.waiting_time );
   executed_foreground_actions.merge( other.executed_foreground_actions );
@@ -11839,6 +12009,10 @@ luxurious_sample_data_t::luxurious_sample_data_t( player_t& p, std::string n ) :
   player( p ),
   buffer_value( 0.0 )
 {
+  if ( p.sim -> streaming_statistics )
+  {
+    change_streaming( true );
+  }
 
 }
 
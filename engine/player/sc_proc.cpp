@@ -1215,6 +1215,8 @@ bool special_effect::usable_proc( const special_effect_t& effect )
  */
 void dbc_proc_callback_t::initialize()
 {
+  crn_stream.key = listener -> sim -> crn_key( listener -> name_str + "/proc/" + effect.name() );
+
   if ( listener -> sim -> debug )
     listener -> sim -> out_debug.printf( "Initializing proc %s: %s",
         effect.name().c_str(), effect.to_string().c_str() );
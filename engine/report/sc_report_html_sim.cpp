@@ -1333,6 +1333,97 @@ void print_nothing_to_report( report::sc_html_stream& os,
      << "</div>\n\n";
 }
 
+// An actor section of the report, including the pets reported separately
+struct actor_report_t
+{
+  player_t* actor;
+  int index;
+  bool target;
+  // Rendered section and its charts, when rendered ahead of time
+  std::string html;
+  sim_t::chart_data_list_t charts;
+
+  actor_report_t( player_t* a, int i, bool t ) : actor( a ), index( i ), target( t )
+  { }
+};
+
+void print_html_actor( report::sc_html_stream& os, sim_t& sim, const actor_report_t& r )
+{
+  report::print_html_player( os, *r.actor, r.index );
+
+  // Pets
+  if ( sim.report_pets_separately )
+  {
+    for ( auto& pet : r.actor->pet_list )
+    {
+      // Target pets are reported whether summoned or not
+      if ( r.target || ( pet->summoned && !pet->quiet ) )
+        report::print_html_player( os, *pet, 1 );
+    }
+  }
+}
+
+/* Print the actor sections of the report. With multiple threads, the sections are rendered
+ * concurrently into their own buffers and collect their charts separately, after which both are
+ * added to the report in order.
+ */
+void print_html_actors( report::sc_html_stream& os, sim_t& sim, std::vector<actor_report_t>& reports )
+{
+  size_t n_threads = std::min( reports.size(), as<size_t>( std::max( 1, sim.threads ) ) );
+  if ( n_threads <= 1 )
+  {
+    for ( const auto& r : reports )
+    {
+      print_html_actor( os, sim, r );
+    }
+    return;
+  }
+
+  std::atomic<size_t> next( 0 );
+
+  auto worker = [ & ]() {
+    size_t i;
+    while ( ( i = next++ ) < reports.size() )
+    {
+      auto& r = reports[ i ];
+
+      std::stringbuf buffer;
+      report::sc_html_stream section;
+      static_cast<std::ostream&>( section ).rdbuf( &buffer );
+      section.flags( os.flags() );
+      section.precision( os.precision() );
+
+      sim_t::redirect_chart_data( &r.charts );
+      try
+      {
+        print_html_actor( section, sim, r );
+      }
+      catch ( ... )
+      {
+        sim_t::redirect_chart_data( nullptr );
+        throw;
+      }
+      sim_t::redirect_chart_data( nullptr );
+
+      r.html = buffer.str();
+    }
+  };
+
+  // The first error of the workers is rethrown by wait()
+  thread::task_group_t workers;
+  for ( size_t i = 0; i < n_threads; ++i )
+  {
+    workers.run( worker );
+  }
+  workers.wait();
+
+  for ( auto& r : reports )
+  {
+    os << r.html;
+    sim.add_chart_data( r.charts );
+  }
+}
+
 /* Main function building the html document and calling subfunctions
  */
 void print_html_( report::sc_html_stream& os, sim_t& sim )
@@ -1389,20 +1480,12 @@ void print_html_( report::sc_html_stream& os, sim_t& sim )
   int k = 0;  // Counter for both players and enemies, without pets.
 
   // Report Players
+  std::vector<actor_report_t> players;
   for ( auto& player : sim.players_by_name )
   {
-    report::print_html_player( os, *player, k );
-
-    // Pets
-    if ( sim.report_pets_separately )
-    {
-      for ( auto& pet : player->pet_list )
-      {
-        if ( pet->summoned && !pet->quiet )
-          report::print_html_player( os, *pet, 1 );
-      }
-    }
+    players.push_back( actor_report_t( player, k, false ) );
   }
+  print_html_actors( os, sim, players );
 
   sim.profilesets.output( sim, os );
 
@@ -1414,21 +1497,13 @@ void print_html_( report::sc_html_stream& os, sim_t& sim )
   // Report Targets
   if ( sim.report_targets )
   {
+    std::vector<actor_report_t> targets;
     for ( auto& player : sim.targets_by_name )
     {
-      report::print_html_player( os, *player, k );
+      targets.push_back( actor_report_t( player, k, true ) );
       ++k;
-
-      // Pets
-      if ( sim.report_pets_separately )
-      {
-        for ( auto& pet : player->pet_list )
-        {
-          // if ( pet -> summoned )
-          report::print_html_player( os, *pet, 1 );
-        }
-      }
     }
+    print_html_actors( os, sim, targets );
   }
 
   print_html_help_boxes( os, sim );
@@ -837,6 +837,28 @@ void collected_data_to_json( JsonOutput root, const player_t& p )
   add_non_zero( root, "fight_length", cd.fight_length );
   add_non_zero( root, "waiting_time", cd.waiting_time );
   add_non_zero( root, "executed_foreground_actions", cd.executed_foreground_actions );
+  if ( sim.cache_action_readiness )
+  {
+    root[ "ready_evaluations" ] = p.ready_evaluations;
+    root[ "ready_evaluations_saved" ] = p.ready_evaluations_saved;
+  }
+  if ( sim.stat_cache_counters )
+  {
+    auto node = root[ "stat_cache" ];
+    node.make_array();
+    for ( cache_e c = CACHE_NONE; c < CACHE_MAX; c++ )
+    {
+      const auto& counter = p.cache.counters[ c ];
+      if ( counter.hits + counter.misses + counter.invalidations == 0 )
+        continue;
+
+      auto entry = node.add();
+      entry[ "name" ] = util::cache_type_string( c );
+      entry[ "hits" ] = counter.hits;
+      entry[ "misses" ] = counter.misses;
+      entry[ "invalidations" ] = counter.invalidations;
+    }
+  }
   add_non_zero( root, "dmg", cd.dmg );
   add_non_zero( root, "compound_dmg", cd.compound_dmg );
   add_non_zero( root, "timeline_dmg", cd.timeline_dmg );
@@ -1504,6 +1526,8 @@ js::sc_js_t to_json( const plot_t& o )
   node.set( "dps_plot_debug", o.dps_plot_debug );
   node.set( "dps_plot_positive", o.dps_plot_positive );
   node.set( "dps_plot_negative", o.dps_plot_negative );
+  node.set( "dps_plot_concurrent", o.dps_plot_concurrent );
+  node.set( "dps_plot_adaptive", o.dps_plot_adaptive );
   return node;
 }
 
@@ -1536,7 +1560,7 @@ void iteration_data_to_json( JsonOutput root, const std::vector<iteration_data_e
   } );
 }
 
-void to_json( JsonOutput root, const sim_t& sim )
+void sim_options_to_json( JsonOutput root, const sim_t& sim )
 {
   // Sim-scope options
   auto options_root = root[ "options" ];
@@ -1569,12 +1593,16 @@ void to_json( JsonOutput root, const sim_t& sim )
   options_root[ "ignite_sampling_delta" ] =  sim.ignite_sampling_delta;
   options_root[ "fixed_time" ] = sim.fixed_time;
   options_root[ "optimize_expressions" ] = sim.optimize_expressions;
+  options_root[ "compile_expressions" ] = sim.compile_expressions;
+  options_root[ "cache_action_readiness" ] = sim.cache_action_readiness;
   options_root[ "optimal_raid" ] = sim.optimal_raid;
   options_root[ "log" ] = sim.log;
   options_root[ "debug_each" ] = sim.debug_each;
   options_root[ "auto_ready_trigger" ] = sim.auto_ready_trigger;
   options_root[ "stat_cache" ] = sim.stat_cache;
+  options_root[ "stat_cache_counters" ] = sim.stat_cache_counters;
   options_root[ "max_aoe_enemies" ] = sim.max_aoe_enemies;
+  options_root[ "aoe_snapshot_once" ] = sim.aoe_snapshot_once;
   options_root[ "show_etmi" ] = sim.show_etmi;
   options_root[ "tmi_window_global" ] = sim.tmi_window_global;
   options_root[ "tmi_bin_size" ] = sim.tmi_bin_size;
@@ -1583,7 +1611,11 @@ void to_json( JsonOutput root, const sim_t& sim )
   options_root[ "timewalk" ] = sim.timewalk;
   options_root[ "pvp_crit" ] = sim.pvp_crit;
   options_root[ "rng" ] = sim.rng();
+  options_root[ "rng_buffer" ] = sim.rng_buffer;
   options_root[ "deterministic" ] = sim.deterministic;
+  options_root[ "common_random_numbers" ] = sim.common_random_numbers;
+  options_root[ "event_queue" ] = sim.event_mgr.queue_name();
+  options_root[ "streaming_statistics" ] = sim.streaming_statistics;
   options_root[ "average_range" ] = sim.average_range;
   options_root[ "average_gauss" ] = sim.average_gauss;
   options_root[ "fight_style" ] = sim.fight_style;
@@ -1604,6 +1636,7 @@ void to_json( JsonOutput root, const sim_t& sim )
     add_non_zero( scaling_root, "positive_scale_delta", sim.scaling -> positive_scale_delta );
     add_non_zero( scaling_root, "scale_lag", sim.scaling -> scale_lag );
     add_non_zero( scaling_root, "center_scale_delta", sim.scaling -> center_scale_delta );
+    add_non_zero( scaling_root, "concurrent_scale_factors", sim.scaling -> concurrent_scale_factors );
   }
 
   // Overrides
@@ -1621,20 +1654,10 @@ void to_json( JsonOutput root, const sim_t& sim )
   {
     overrides[ "target_health" ] = sim.overrides.target_health;
   }
+}
 
-  // Players
-  JsonOutput players_arr = root[ "players" ].make_array();
-
-  range::for_each( sim.player_no_pet_list.data(), [ &players_arr ]( const player_t* p ) {
-    to_json( players_arr, *p );
-  } );
-
-  if ( sim.profilesets.n_profilesets() > 0 )
-  {
-    auto profileset_root = root[ "profilesets" ];
-    sim.profilesets.output( sim, profileset_root );
-  }
-
+void sim_statistics_to_json( JsonOutput root, const sim_t& sim )
+{
   auto stats_root = root[ "statistics" ];
   stats_root[ "elapsed_cpu_seconds" ] = sim.elapsed_cpu;
   stats_root[ "elapsed_time_seconds" ] = sim.elapsed_time;
@@ -1642,54 +1665,174 @@ void to_json( JsonOutput root, const sim_t& sim )
   stats_root[ "merge_time_seconds" ] = sim.merge_time;
   stats_root[ "analyze_time_seconds" ] = sim.analyze_time;
   stats_root[ "simulation_length" ] = sim.simulation_length;
+
+  auto alloc_arr = stats_root[ "event_allocation" ].make_array();
+  for ( size_t i = 0; i < sim.event_mgr.event_size_classes.size(); ++i )
+  {
+    const auto& sc = sim.event_mgr.event_size_classes[ i ];
+    if ( sc.requested == 0 )
+    {
+      continue;
+    }
+
+    auto entry = alloc_arr.add();
+    entry[ "size" ] = 1U << ( event_manager_t::EVENT_MIN_SIZE_SHIFT + i );
+    entry[ "requested" ] = sc.requested;
+    entry[ "allocated" ] = sc.allocated;
+  }
   add_non_zero( stats_root, "raid_dps", sim.raid_dps );
   add_non_zero( stats_root, "raid_hps", sim.raid_hps );
   add_non_zero( stats_root, "raid_aps", sim.raid_aps );
   add_non_zero( stats_root, "total_dmg", sim.total_dmg );
   add_non_zero( stats_root, "total_heal", sim.total_heal );
   add_non_zero( stats_root, "total_absorb", sim.total_absorb );
+}
 
-  if ( sim.report_details != 0 )
+// Sim-wide report details, apart from the targets
+void sim_details_to_json( JsonOutput root, const sim_t& sim )
+{
+  // Raid events
+  if ( ! sim.raid_events.empty() )
   {
-    // Targets
-    JsonOutput targets_arr = root[ "targets" ].make_array();
+    auto arr = root[ "raid_events" ].make_array();
 
-    range::for_each( sim.target_list.data(), [ &targets_arr ]( const player_t* p ) {
-      to_json( targets_arr, *p );
+    range::for_each( sim.raid_events, [ &arr ]( const std::unique_ptr<raid_event_t>& event ) {
+      to_json( arr, *event );
     } );
+  }
 
-    // Raid events
-    if ( ! sim.raid_events.empty() )
-    {
-      auto arr = root[ "raid_events" ].make_array();
+  if ( sim.buff_list.size() > 0 )
+  {
+    JsonOutput buffs_arr = root[ "sim_auras" ].make_array();
+    range::for_each( sim.buff_list, [ &buffs_arr ]( const buff_t* b ) {
+      if ( b -> avg_start.mean() == 0 )
+      {
+        return;
+      }
+      to_json( buffs_arr.add(), b );
+    } );
+  }
 
-      range::for_each( sim.raid_events, [ &arr ]( const std::unique_ptr<raid_event_t>& event ) {
-        to_json( arr, *event );
-      } );
-    }
+  if ( sim.low_iteration_data.size() > 0 )
+  {
+    iteration_data_to_json( root[ "iteration_data" ][ "low" ], sim.low_iteration_data );
+  }
 
-    if ( sim.buff_list.size() > 0 )
-    {
-      JsonOutput buffs_arr = root[ "sim_auras" ].make_array();
-      range::for_each( sim.buff_list, [ &buffs_arr ]( const buff_t* b ) {
-        if ( b -> avg_start.mean() == 0 )
-        {
-          return;
-        }
-        to_json( buffs_arr.add(), b );
-      } );
-    }
+  if ( sim.high_iteration_data.size() > 0 )
+  {
+    iteration_data_to_json( root[ "iteration_data" ][ "high" ], sim.high_iteration_data );
+  }
+}
+
+/**
+ * The json2 report is streamed to the output instead of being built as a single document. Each
+ * section, and each actor, is built as a separate small document that is written out and released
+ * before the next one is built, so peak memory is bound by the largest actor instead of the whole
+ * report.
+ */
 
-    if ( sim.low_iteration_data.size() > 0 )
+// Write the members of the object built by fn into the object currently open in the writer
+template <typename Writer, typename Fn>
+void write_members( Writer& writer, Fn fn )
+{
+  Document doc;
+  doc.SetObject();
+
+  JsonOutput root( doc, doc );
+  fn( root );
+
+  for ( auto it = doc.MemberBegin(); it != doc.MemberEnd(); ++it )
+  {
+    writer.Key( it -> name.GetString(), it -> name.GetStringLength() );
+    it -> value.Accept( writer );
+  }
+}
+
+// Write an array of actors, one actor document at a time
+template <typename Writer>
+void write_actors( Writer& writer, const char* name, const std::vector<player_t*>& actors )
+{
+  writer.Key( name );
+  writer.StartArray();
+
+  for ( const player_t* p : actors )
+  {
+    Document doc;
+    doc.SetArray();
+
+    JsonOutput arr( doc, doc );
+    to_json( arr, *p );
+
+    for ( auto it = doc.Begin(); it != doc.End(); ++it )
     {
-      iteration_data_to_json( root[ "iteration_data" ][ "low" ], sim.low_iteration_data );
+      it -> Accept( writer );
     }
+  }
 
-    if ( sim.high_iteration_data.size() > 0 )
+  writer.EndArray();
+}
+
+template <typename Writer>
+void write_json2( Writer& writer, const sim_t& sim )
+{
+  writer.StartObject();
+
+  writer.Key( "version" );
+  writer.String( SC_VERSION );
+  writer.Key( "ptr_enabled" );
+  writer.Int( SC_USE_PTR );
+  writer.Key( "beta_enabled" );
+  writer.Int( SC_BETA );
+  writer.Key( "build_date" );
+  writer.String( __DATE__ );
+  writer.Key( "build_time" );
+  writer.String( __TIME__ );
+  if ( git_info::available() )
+  {
+    writer.Key( "git_revision" );
+    writer.String( git_info::revision() );
+    writer.Key( "git_branch" );
+    writer.String( git_info::branch() );
+  }
+
+  writer.Key( "sim" );
+  writer.StartObject();
+
+  write_members( writer, [ &sim ]( JsonOutput root ) { sim_options_to_json( root, sim ); } );
+
+  write_actors( writer, "players", sim.player_no_pet_list.data() );
+
+  if ( sim.profilesets.n_profilesets() > 0 )
+  {
+    write_members( writer, [ &sim ]( JsonOutput root ) {
+      auto profileset_root = root[ "profilesets" ];
+      sim.profilesets.output( sim, profileset_root );
+    } );
+  }
+
+  write_members( writer, [ &sim ]( JsonOutput root ) { sim_statistics_to_json( root, sim ); } );
+
+  if ( sim.report_details != 0 )
+  {
+    write_actors( writer, "targets", sim.target_list.data() );
+
+    write_members( writer, [ &sim ]( JsonOutput root ) { sim_details_to_json( root, sim ); } );
+  }
+
+  writer.EndObject();
+
+  if ( sim.error_list.size() > 0 )
+  {
+    writer.Key( "notifications" );
+    writer.StartArray();
+    for ( const auto& error : sim.error_list )
     {
-      iteration_data_to_json( root[ "iteration_data" ][ "high" ], sim.high_iteration_data );
+      writer.String( error.c_str(), as<SizeType>( error.size() ) );
     }
+    writer.EndArray();
   }
+
+  writer.EndObject();
 }
 
 js::sc_js_t to_json( const sim_t& sim )
@@ -1735,12 +1878,16 @@ js::sc_js_t to_json( const sim_t& sim )
   node.set( "ignite_sampling_delta", to_json( sim.ignite_sampling_delta ) );
   node.set( "fixed_time", sim.fixed_time );
   node.set( "optimize_expressions", sim.optimize_expressions );
+  node.set( "compile_expressions", sim.compile_expressions );
+  node.set( "cache_action_readiness", sim.cache_action_readiness );
   node.set( "optimal_raid", sim.optimal_raid );
   node.set( "log", sim.log );
   node.set( "debug_each", sim.debug_each );
   node.set( "auto_ready_trigger", sim.auto_ready_trigger );
   node.set( "stat_cache", sim.stat_cache );
+  node.set( "stat_cache_counters", sim.stat_cache_counters );
   node.set( "max_aoe_enemies", sim.max_aoe_enemies );
+  node.set( "aoe_snapshot_once", sim.aoe_snapshot_once );
   node.set( "show_etmi", sim.show_etmi );
   node.set( "tmi_window_global", sim.tmi_window_global );
   node.set( "tmi_bin_size", sim.tmi_bin_size );
@@ -1750,8 +1897,10 @@ js::sc_js_t to_json( const sim_t& sim )
   node.set( "challenge_mode", sim.challenge_mode );
   node.set( "pvp_crit", sim.pvp_crit );
   node.set( "rng", to_json( sim.rng() ) );
+  node.set( "rng_buffer", sim.rng_buffer );
   node.set( "rng_seed", sim.seed );
   node.set( "deterministic", sim.deterministic );
+  node.set( "common_random_numbers", sim.common_random_numbers );
   node.set( "average_range", sim.average_range );
   node.set( "average_gauss", sim.average_gauss );
   for ( const auto& re : sim.raid_events )
@@ -1820,37 +1969,30 @@ js::sc_js_t get_root( const sim_t& sim )
   return root;
 }
 
-void print_json2_pretty( FILE* o, const sim_t& sim )
+void print_json2( FILE* o, const sim_t& sim )
 {
-  Document doc;
-  Value& v = doc;
-  v.SetObject();
-
-  JsonOutput root( doc, v );
+  std::array<char, 65536> buffer;
+  FileWriteStream b( o, buffer.data(), buffer.size() );
+  bool accepted;
 
-  root[ "version" ] = SC_VERSION;
-  root[ "ptr_enabled" ] = SC_USE_PTR;
-  root[ "beta_enabled" ] = SC_BETA;
-  root[ "build_date" ] = __DATE__;
-  root[ "build_time" ] = __TIME__;
-  if ( git_info::available())
+  if ( sim.json2_compact )
   {
-    root[ "git_revision" ] = git_info::revision();
-    root[ "git_branch" ] = git_info::branch();
+    Writer<FileWriteStream> writer( b );
+    write_json2( writer, sim );
+    accepted = writer.IsComplete();
   }
-
-  to_json( root[ "sim" ], sim );
-
-  if ( sim.error_list.size() > 0 )
+  else
   {
-    root[ "notifications" ] = sim.error_list;
+    PrettyWriter<FileWriteStream> writer( b );
+    write_json2( writer, sim );
+    accepted = writer.IsComplete();
   }
 
-  std::array<char, 16384> buffer;
-  FileWriteStream b( o, buffer.data(), buffer.size() );
-  PrettyWriter<FileWriteStream> writer( b );
-  auto accepted = doc.Accept( writer );
-  if ( !accepted )
+  b.Flush();
+
+  // The streamed document is only complete if every value was accepted, and the file stream
+  // reports write errors on flush
+  if ( ! accepted || ferror( o ) )
   {
     throw std::runtime_error("JSON Writer did not accept document.");
   }
@@ -1923,7 +2065,7 @@ void print_json( sim_t& sim )
       {
         t.start();
       }
-      print_json2_pretty( s, sim );
+      print_json2( s, sim );
     }
     catch ( const std::exception& e )
     {
@@ -584,6 +584,42 @@ void print_text_waiting( FILE* file, player_t* p )
   util::fprintf( file, "  Waiting: %4.2f%%", 100.0 * wait_time );
 }
 
+// print_text_readiness_cache ================================================
+
+void print_text_readiness_cache( FILE* file, player_t* p )
+{
+  uint64_t total = p->ready_evaluations + p->ready_evaluations_saved;
+  if ( total == 0 )
+    return;
+
+  util::fprintf( file, "\n  Readiness: Checks=%" PRIu64 " Cached=%" PRIu64 " (%.1f%%)",
+                 total, p->ready_evaluations_saved,
+                 100.0 * p->ready_evaluations_saved / total );
+}
+
+// print_text_stat_cache =====================================================
+
+void print_text_stat_cache( FILE* file, player_t* p )
+{
+  util::fprintf( file, "\n  Stat Cache:\n" );
+  double iterations = std::max( 1, p->sim->iterations );
+
+  for ( cache_e c = CACHE_NONE; c < CACHE_MAX; c++ )
+  {
+    const auto& counter = p->cache.counters[ c ];
+    uint64_t total = counter.hits + counter.misses;
+    if ( total + counter.invalidations == 0 )
+      continue;
+
+    util::fprintf( file,
+                   "    %-24s Hits=%" PRIu64 " Misses=%" PRIu64 " (%.1f%%) Invalidations=%" PRIu64
+                   " (%.1f per iteration)\n",
+                   util::cache_type_string( c ), counter.hits, counter.misses,
+                   total ? 100.0 * counter.misses / total : 0.0, counter.invalidations,
+                   counter.invalidations / iterations );
+  }
+}
+
 // print_text_waiting_all
 // =======================================================
 
@@ -744,20 +780,30 @@ void print_text_performance( FILE* file, sim_t* sim )
   char date_str[ sizeof "2011-10-08 07:07:09+0000" ];
   std::strftime( date_str, sizeof date_str, "%Y-%m-%d %H:%M:%S%z",
                  std::localtime( &cur_time ) );
-  std::stringstream iterations_str;
+  std::stringstream iterations_str, work_str;
   if ( sim -> threads > 1 )
   {
     iterations_str << " (";
+    work_str << "  WorkChunks    = ";
     for ( size_t i = 0; i < sim -> work_per_thread.size(); ++i )
     {
       iterations_str << sim -> work_per_thread[ i ];
+      work_str << sim -> work_claims_per_thread[ i ] << "/" << sim -> work_idle_per_thread[ i ];
 
       if ( i < sim -> work_per_thread.size() - 1 )
       {
         iterations_str << ", ";
+        work_str << ", ";
       }
     }
     iterations_str << ")";
+    work_str << " (claims/idle)\n";
+  }
+
+  uint64_t total_allocated_events = 0;
+  for ( const auto& sc : sim->event_mgr.event_size_classes )
+  {
+    total_allocated_events += sc.allocated;
   }
 
   util::fprintf(
@@ -765,10 +811,12 @@ void print_text_performance( FILE* file, sim_t* sim )
       "\nBaseline Performance:\n"
       "  RNG Engine    = %s%s\n"
       "  Iterations    = %d%s\n"
+      "%s"
+      "  EventQueue    = %s\n"
       "  TotalEvents   = %lu\n"
       "  MaxEventQueue = %lu\n"
+      "  AllocEvents   = %" PRIu64 "\n"
 #ifdef EVENT_QUEUE_DEBUG
-      "  AllocEvents   = %u\n"
       "  EndInsert     = %u (%.3f%%)\n"
       "  MaxTravDepth  = %u\n"
       "  AvgTravDepth  = %.3f\n"
@@ -781,14 +829,18 @@ void print_text_performance( FILE* file, sim_t* sim )
       "  MergeSeconds  = %.6f\n"
       "  AnalyzeSeconds= %.6f\n"
       "  SpeedUp       = %.0f\n"
+      "  EventsPerSec  = %.0f\n"
       "  EndTime       = %s (%.0f)\n\n",
       sim->rng().name(), sim->deterministic ? " (deterministic)" : "",
       sim->iterations,
       sim -> threads > 1 ? iterations_str.str().c_str() : "",
+      work_str.str().c_str(),
+      sim->event_mgr.queue_name(),
       sim->event_mgr.total_events_processed,
       sim->event_mgr.max_events_remaining,
+      total_allocated_events,
 #ifdef EVENT_QUEUE_DEBUG
-      sim->event_mgr.n_allocated_events, sim->event_mgr.n_end_insert,
+      sim->event_mgr.n_end_insert,
       100.0 * static_cast<double>( sim->event_mgr.n_end_insert ) /
           sim->event_mgr.events_added,
       sim->event_mgr.max_queue_depth,
@@ -802,6 +854,7 @@ void print_text_performance( FILE* file, sim_t* sim )
       sim->merge_time,
       sim->analyze_time,
       sim->iterations * sim->simulation_length.mean() / sim->elapsed_cpu,
+      sim->event_mgr.total_events_processed / sim->elapsed_cpu,
       date_str, static_cast<double>( cur_time ) );
 #ifdef EVENT_QUEUE_DEBUG
   double total_p = 0;
@@ -831,29 +884,19 @@ void print_text_performance( FILE* file, sim_t* sim )
   util::fprintf( file, "Total: %.3f%% Samples: %llu\n", total_p,
                  sim->event_mgr.events_added );
 
-  util::fprintf( file, "\nEvent Queue Allocation:\n" );
-  double total_a = 0;
-  for ( size_t i = 0; i < sim->event_mgr.event_requested_size_count.size();
-        ++i )
+  util::fprintf( file, "\nEvent Allocation:\n" );
+  for ( size_t i = 0; i < sim->event_mgr.event_size_classes.size(); ++i )
   {
-    if ( sim->event_mgr.event_requested_size_count[ i ] == 0 )
+    const auto& sc = sim->event_mgr.event_size_classes[ i ];
+    if ( sc.requested == 0 )
     {
       continue;
     }
 
-    double p =
-        100.0 *
-        static_cast<double>( sim->event_mgr.event_requested_size_count[ i ] ) /
-        sim->event_mgr.n_requested_events;
-    util::fprintf( file, "Alloc-Size: %-4u Samples: %-7u (%.3f%%)\n", i,
-                   sim->event_mgr.event_requested_size_count[ i ], p );
-
-    total_a += p;
+    util::fprintf( file, "  Size-Class: %-4u Requests: %-10" PRIu64 " Allocated: %-7" PRIu64 " (%.3f%% recycled)\n",
+                   1U << ( event_manager_t::EVENT_MIN_SIZE_SHIFT + i ), sc.requested, sc.allocated,
+                   100.0 * ( sc.requested - sc.allocated ) / sc.requested );
   }
-
-  util::fprintf( file, "Total: %.3f%% Alloc Samples: %llu\n", total_p,
-                 sim->event_mgr.n_requested_events );
-  util::fprintf( file, "Alloc size used for event_t: %u\n", util::next_power_of_two( 2 * sizeof( event_t ) ) );
 #endif
 }
 
@@ -996,7 +1039,11 @@ void print_text_dps_plots( FILE* file, player_t* p )
       size_t num_points = pd.size();
       for ( size_t j = 0; j < num_points; j++ )
       {
-        util::fprintf( file, "%s%.0f", ( j ? "|" : "" ), pd[ j ].value );
+        // Adaptive plots are not evenly spaced, so include the stat delta of every point
+        if ( sim->plot->dps_plot_adaptive )
+          util::fprintf( file, "%s%.0f@%.1f", ( j ? "|" : "" ), pd[ j ].value, pd[ j ].plot_step );
+        else
+          util::fprintf( file, "%s%.0f", ( j ? "|" : "" ), pd[ j ].value );
       }
       util::fprintf( file, "\n" );
     }
@@ -1227,6 +1274,10 @@ void print_text_player( FILE* file, player_t* p )
   print_text_scale_factors( file, p, p->report_information );
   print_text_dps_plots( file, p );
   print_text_waiting( file, p );
+  if ( p->sim->cache_action_readiness )
+    print_text_readiness_cache( file, p );
+  if ( p->sim->stat_cache_counters )
+    print_text_stat_cache( file, p );
 }
 
 void print_text_report( FILE* file, sim_t* sim, bool detail )
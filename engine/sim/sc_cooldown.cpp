@@ -37,6 +37,7 @@ struct recharge_event_t : event_t
     assert( cooldown_ -> current_charge < cooldown_ -> charges );
     cooldown_ -> current_charge++;
     cooldown_ -> ready = cooldown_t::ready_init();
+    cooldown_ -> version++;
 
     if ( cooldown_ -> current_charge < cooldown_ -> charges )
     {
@@ -86,6 +87,27 @@ struct ready_trigger_event_t : public player_event_t
   }
 };
 
+// Expressions on the ready state of a cooldown. The state changes when the cooldown is started,
+// adjusted or recharged, which bumps its version, or when the cooldown comes up.
+struct cooldown_state_expr_t : public expr_t
+{
+  const cooldown_t* cd;
+
+  cooldown_state_expr_t( const std::string& n, const cooldown_t* c ) :
+    expr_t( n ), cd( c )
+  { }
+
+  bool dependencies( expr_dependencies_t& deps ) override
+  {
+    deps.add( cd -> version );
+    if ( ! cd -> up() )
+    {
+      deps.expires( cd -> ready );
+    }
+    return true;
+  }
+};
+
 } // UNNAMED NAMESPACE
 
 timespan_t cooldown_t::cooldown_duration( const cooldown_t* cd,
@@ -126,7 +148,8 @@ cooldown_t::cooldown_t( const std::string& n, player_t& p ) :
   last_charged( timespan_t::zero() ),
   recharge_multiplier( 1.0 ),
   hasted( false ),
-  action( nullptr )
+  action( nullptr ),
+  version( 0 )
 {}
 
 cooldown_t::cooldown_t( const std::string& n, sim_t& s ) :
@@ -144,7 +167,8 @@ cooldown_t::cooldown_t( const std::string& n, sim_t& s ) :
   last_charged( timespan_t::zero() ),
   recharge_multiplier( 1.0 ),
   hasted( false ),
-  action( nullptr )
+  action( nullptr ),
+  version( 0 )
 {}
 
 // Adjust a dynamic cooldown (reduction) multiplier based on the current action associated with the
@@ -198,6 +222,7 @@ void cooldown_t::adjust_recharge_multiplier()
   if ( ! up() )
   {
     ready = sim.current_time() + new_remains;
+    version++;
   }
   if ( charges == 1 )
   {
@@ -207,6 +232,8 @@ void cooldown_t::adjust_recharge_multiplier()
 
 void cooldown_t::adjust( timespan_t amount, bool require_reaction )
 {
+  version++;
+
   // Normal cooldown, just adjust as we see fit
   if ( charges == 1 )
   {
@@ -287,6 +314,7 @@ void cooldown_t::adjust( timespan_t amount, bool require_reaction )
 
 void cooldown_t::reset_init()
 {
+  version++;
   ready = ready_init();
   last_start = timespan_t::zero();
   last_charged = timespan_t::zero();
@@ -302,6 +330,7 @@ void cooldown_t::reset( bool require_reaction, bool all_charges )
 {
   bool was_down = down();
   ready = ready_init();
+  version++;
   if ( last_start > sim.current_time() )
     last_start = timespan_t::zero();
   if ( charges == 1 || all_charges )
@@ -340,6 +369,7 @@ void cooldown_t::start( action_t* a, timespan_t _override, timespan_t delay )
   reset_react = timespan_t::zero();
 
   action = a;
+  version++;
 
   if ( a )
   {
@@ -406,19 +436,39 @@ expr_t* cooldown_t::create_expression( action_t*, const std::string& name_str )
   else if ( name_str == "duration" )
     return make_ref_expr( name_str, duration );
   else if ( name_str == "up" || name_str == "ready" )
-    return make_mem_fn_expr( name_str, *this, &cooldown_t::up );
+  {
+    struct up_expr_t : public cooldown_state_expr_t
+    {
+      up_expr_t( const std::string& n, const cooldown_t* c ) :
+        cooldown_state_expr_t( n, c )
+      { }
+
+      double evaluate() override
+      { return cd -> up(); }
+    };
+    return new up_expr_t( name_str, this );
+  }
   else if ( name_str == "charges" )
   {
-    return make_fn_expr( name_str, [ this ]() {
-      if ( charges <= 1 )
-      {
-        return up() ? 1.0 : 0.0;
-      }
-      else
+    struct charges_expr_t : public cooldown_state_expr_t
+    {
+      charges_expr_t( const std::string& n, const cooldown_t* c ) :
+        cooldown_state_expr_t( n, c )
+      { }
+
+      double evaluate() override
       {
-        return as<double>( current_charge );
+        if ( cd -> charges <= 1 )
+        {
+          return cd -> up() ? 1.0 : 0.0;
+        }
+        else
+        {
+          return as<double>( cd -> current_charge );
+        }
       }
-    } );
+    };
+    return new charges_expr_t( name_str, this );
   }
   else if ( name_str == "charges_fractional" )
   {
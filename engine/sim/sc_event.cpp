@@ -4,6 +4,29 @@
 // ==========================================================================
 
 #include "simulationcraft.hpp"
+#include <cstdlib>
+#if defined( SC_WINDOWS )
+#include <malloc.h>
+#endif
+
+namespace
+{
+// Index of the lowest set bit in a non-zero 64-bit mask
+inline unsigned lowest_bit( uint64_t v )
+{
+#if defined( SC_GCC ) || defined( SC_CLANG )
+  return static_cast<unsigned>( __builtin_ctzll( v ) );
+#else
+  unsigned n = 0;
+  while ( !( v & 1 ) )
+  {
+    v >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+}  // unnamed namespace
 
 // ==========================================================================
 // Event
@@ -79,6 +102,46 @@ void event_t::cancel( event_t*& e )
   e           = nullptr;
 }
 
+namespace {
+
+// Slab of the event allocator, aligned to event_manager_t::EVENT_SLAB_SIZE
+void* allocate_slab()
+{
+  void* slab = nullptr;
+#if defined( SC_WINDOWS )
+  slab = _aligned_malloc( event_manager_t::EVENT_SLAB_SIZE, event_manager_t::EVENT_SLAB_SIZE );
+#else
+  if ( posix_memalign( &slab, event_manager_t::EVENT_SLAB_SIZE, event_manager_t::EVENT_SLAB_SIZE ) != 0 )
+  {
+    slab = nullptr;
+  }
+#endif
+  if ( !slab )
+  {
+    throw std::bad_alloc();
+  }
+
+  return slab;
+}
+
+void free_slab( void* slab )
+{
+#if defined( SC_WINDOWS )
+  _aligned_free( slab );
+#else
+  free( slab );
+#endif
+}
+
+// Size class of an event, stored in the header of the slab containing it
+unsigned& slab_size_class( void* p )
+{
+  uintptr_t slab = reinterpret_cast<uintptr_t>( p ) & ~uintptr_t( event_manager_t::EVENT_SLAB_SIZE - 1 );
+  return *reinterpret_cast<unsigned*>( slab );
+}
+
+} // unnamed namespace
+
 // ==========================================================================
 // Event Manager
 // ==========================================================================
@@ -95,19 +158,25 @@ event_manager_t::event_manager_t( sim_t* s )
     global_event_id( 1 ),  // start at 1, so we can identify event -> id == 0
                            // meaning a unscheduled event.
     timing_wheel(),
-    recycled_event_list( nullptr ),
     wheel_seconds( 0 ),
     wheel_size( 0 ),
     wheel_mask( 0 ),
     wheel_shift( 5 ),
     wheel_granularity( 0.0 ),
     wheel_time( timespan_t::zero() ),
+    event_size_classes(),
+    event_slabs(),
+    allocated_events(),
+    queue_str(),
+    queue_type( QUEUE_WHEEL ),
+    hw_head(),
+    hw_tail(),
+    hw_occupied(),
+    hw_time( 0 ),
     event_stopwatch( STOPWATCH_THREAD ),
 #ifdef EVENT_QUEUE_DEBUG
     monitor_cpu( false ),
     max_queue_depth( 0 ),
-    n_allocated_events( 0 ),
-    n_requested_events( 0 ),
     n_end_insert( 0 ),
     events_traversed( 0 ),
     events_added( 0 )
@@ -123,11 +192,10 @@ event_manager_t::event_manager_t( sim_t* s )
 
 event_manager_t::~event_manager_t()
 {
-  while ( recycled_event_list )
+  // Events live in the slabs, so all of them go away with the slabs
+  for ( auto slab : event_slabs )
   {
-    event_t* e          = recycled_event_list;
-    recycled_event_list = e->next;
-    free( e );
+    free_slab( slab );
   }
 }
 
@@ -135,40 +203,34 @@ event_manager_t::~event_manager_t()
 
 void* event_manager_t::allocate_event( const std::size_t size )
 {
-  static const std::size_t SIZE = util::next_power_of_two( 2 * sizeof( event_t ) );
-  assert( SIZE > size );
-  (void)size;
+  assert( size <= EVENT_MAX_SIZE );
 
-  event_t* e = recycled_event_list;
-#ifdef EVENT_QUEUE_DEBUG
-  n_requested_events++;
-  if ( size >= event_requested_size_count.size() )
-  {
-    event_requested_size_count.resize( size + 1 );
-  }
-  event_requested_size_count[ size ]++;
-#endif
-  if ( e )
+  event_size_class_t& sc = event_size_classes[ event_size_class( size ) ];
+  sc.requested++;
+
+  if ( event_t* e = sc.recycled )
   {
-    recycled_event_list = e->next;
+    sc.recycled = e->next;
+    return e;
   }
-  else
+
+  const unsigned size_class = event_size_class( size );
+  const std::size_t class_size = std::size_t( 1 ) << ( EVENT_MIN_SIZE_SHIFT + size_class );
+  if ( sc.slab_cur == sc.slab_end )
   {
-    e = (event_t*)malloc( SIZE );
+    void* slab = allocate_slab();
+    event_slabs.push_back( slab );
+    slab_size_class( slab ) = size_class;
 
-    if ( !e )
-    {
-      throw std::bad_alloc();
-    }
-    else
-    {
-#ifdef EVENT_QUEUE_DEBUG
-      n_allocated_events++;
-#endif
-      allocated_events.push_back( e );
-    }
+    sc.slab_cur = static_cast<char*>( slab ) + EVENT_SLAB_HEADER;
+    sc.slab_end = sc.slab_cur + ( EVENT_SLAB_SIZE - EVENT_SLAB_HEADER ) / class_size * class_size;
   }
 
+  event_t* e = reinterpret_cast<event_t*>( sc.slab_cur );
+  sc.slab_cur += class_size;
+  sc.allocated++;
+  allocated_events.push_back( e );
+
   return e;
 }
 
@@ -176,10 +238,11 @@ void* event_manager_t::allocate_event( const std::size_t size )
 
 void event_manager_t::recycle_event( event_t* e )
 {
+  event_size_class_t& sc = event_size_classes[ slab_size_class( e ) ];
   e->~event_t();
-  e->recycled         = true;
-  e->next             = recycled_event_list;
-  recycled_event_list = e;
+  e->recycled = true;
+  e->next     = sc.recycled;
+  sc.recycled = e;
 }
 
 // event_manager_t::add_event ===============================================
@@ -192,6 +255,9 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
   if ( delta_time < timespan_t::zero() )
     delta_time = timespan_t::zero();
 
+  // Far-future events are parked at the wheel horizon and rescheduled from
+  // there. This is applied to all queue backends so that event ordering (and
+  // thus results) do not depend on the backend in use.
   if ( delta_time > wheel_time )
   {
     e->time = current_time + wheel_time - timespan_t::from_seconds( 1 );
@@ -203,6 +269,33 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
     e->reschedule_time = timespan_t::zero();
   }
 
+  if ( queue_type == QUEUE_HIERARCHICAL )
+    insert_hierarchical( e );
+  else
+    insert_wheel( e );
+
+  if ( ++events_remaining > max_events_remaining )
+    max_events_remaining = events_remaining;
+
+  if ( sim->debug )
+    sim->out_debug.printf( "Add Event: %s time=%.4f rs-time=%.4f id=%d",
+                           e->name(), e->time.total_seconds(),
+                           e->reschedule_time.total_seconds(), e->id );
+
+#if ACTOR_EVENT_BOOKKEEPING
+  if ( sim->debug && e->actor )
+  {
+    e->actor->event_counter++;
+    sim->out_debug.printf( "Actor %s has %d scheduled events", e->actor->name(),
+                           e->actor->event_counter );
+  }
+#endif
+}
+
+// event_manager_t::insert_wheel ============================================
+
+void event_manager_t::insert_wheel( event_t* e )
+{
   // Determine the timing wheel position to which the event will belong
   // Only valid for integer based timespan_t
   uint32_t slice = static_cast<uint32_t>(
@@ -246,23 +339,39 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
   // insert event
   e->next = *prev;
   *prev   = e;
+}
 
-  if ( ++events_remaining > max_events_remaining )
-    max_events_remaining = events_remaining;
-
-  if ( sim->debug )
-    sim->out_debug.printf( "Add Event: %s time=%.4f rs-time=%.4f id=%d",
-                           e->name(), e->time.total_seconds(),
-                           e->reschedule_time.total_seconds(), e->id );
+// event_manager_t::insert_hierarchical =====================================
 
-#if ACTOR_EVENT_BOOKKEEPING
-  if ( sim->debug && e->actor )
+void event_manager_t::insert_hierarchical( event_t* e )
+{
+  int64_t t = e->time.total_millis();
+  assert( t >= hw_time );
+  assert( ( t >> ( HW_SHIFT * HW_LEVELS ) ) == ( hw_time >> ( HW_SHIFT * HW_LEVELS ) ) );
+
+  // The level is selected by the most significant slot index that differs
+  // from the current wheel time. Slot lists are kept in insertion order, so
+  // events with equal time execute in the same (id) order as on the flat
+  // timing wheel.
+  unsigned level = 0;
+  while ( level < HW_LEVELS - 1 &&
+          ( t >> ( HW_SHIFT * ( level + 1 ) ) ) !=
+              ( hw_time >> ( HW_SHIFT * ( level + 1 ) ) ) )
   {
-    e->actor->event_counter++;
-    sim->out_debug.printf( "Actor %s has %d scheduled events", e->actor->name(),
-                           e->actor->event_counter );
+    level++;
   }
-#endif
+
+  unsigned slot  = static_cast<unsigned>( ( t >> ( HW_SHIFT * level ) ) & ( HW_SLOTS - 1 ) );
+  unsigned index = level * HW_SLOTS + slot;
+
+  e->next = nullptr;
+  if ( hw_tail[ index ] )
+    hw_tail[ index ]->next = e;
+  else
+    hw_head[ index ] = e;
+  hw_tail[ index ] = e;
+
+  hw_occupied[ index >> 6 ] |= uint64_t( 1 ) << ( index & 63 );
 }
 
 // event_manager_t::reschedule_event ========================================
@@ -374,6 +483,9 @@ void event_manager_t::flush()
 
   // Clear Timing Wheel
   timing_wheel.assign( timing_wheel.size(), nullptr );
+  hw_head.assign( hw_head.size(), nullptr );
+  hw_tail.assign( hw_tail.size(), nullptr );
+  hw_occupied.assign( hw_occupied.size(), 0 );
 }
 
 // event_manager_t::init ====================================================
@@ -402,9 +514,32 @@ void event_manager_t::init()
   wheel_size = wheel_mask;
   wheel_mask--;
 
-  // The timing wheel represents an array of event lists: Each time slice has an
-  // event list.
-  timing_wheel.resize( wheel_size );
+  if ( queue_str.empty() || util::str_compare_ci( queue_str, "wheel" ) )
+  {
+    queue_type = QUEUE_WHEEL;
+  }
+  else if ( util::str_compare_ci( queue_str, "hierarchical" ) )
+  {
+    queue_type = QUEUE_HIERARCHICAL;
+  }
+  else
+  {
+    sim->errorf( "Unknown event queue '%s', using timing wheel.", queue_str.c_str() );
+    queue_type = QUEUE_WHEEL;
+  }
+
+  if ( queue_type == QUEUE_WHEEL )
+  {
+    // The timing wheel represents an array of event lists: Each time slice has
+    // an event list.
+    timing_wheel.resize( wheel_size );
+  }
+  else
+  {
+    hw_head.assign( HW_LEVELS * HW_SLOTS, nullptr );
+    hw_tail.assign( HW_LEVELS * HW_SLOTS, nullptr );
+    hw_occupied.assign( HW_LEVELS * HW_SLOTS / 64, 0 );
+  }
 }
 
 // event_manager_t::next_event ==============================================
@@ -414,6 +549,17 @@ event_t* event_manager_t::next_event()
   if ( events_remaining == 0 )
     return nullptr;
 
+  event_t* e = queue_type == QUEUE_HIERARCHICAL ? next_event_hierarchical()
+                                                : next_event_wheel();
+  events_remaining--;
+  events_processed++;
+  return e;
+}
+
+// event_manager_t::next_event_wheel ========================================
+
+event_t* event_manager_t::next_event_wheel()
+{
   while ( true )
   {
     event_t*& event_list = timing_wheel[ timing_slice ];
@@ -421,8 +567,6 @@ event_t* event_manager_t::next_event()
     {
       event_t* e = event_list;
       event_list = e->next;
-      events_remaining--;
-      events_processed++;
       return e;
     }
 
@@ -437,6 +581,89 @@ event_t* event_manager_t::next_event()
   return nullptr;
 }
 
+// event_manager_t::next_event_hierarchical =================================
+
+event_t* event_manager_t::next_event_hierarchical()
+{
+  const unsigned words = HW_SLOTS / 64;
+
+  while ( true )
+  {
+    // Level 0 holds all events within the current HW_SLOTS milliseconds, one
+    // slot per millisecond.
+    for ( unsigned w = 0; w < words; w++ )
+    {
+      if ( !hw_occupied[ w ] )
+        continue;
+
+      unsigned slot = w * 64 + lowest_bit( hw_occupied[ w ] );
+      event_t* e    = hw_head[ slot ];
+      hw_head[ slot ] = e->next;
+      if ( !hw_head[ slot ] )
+      {
+        hw_tail[ slot ] = nullptr;
+        hw_occupied[ w ] &= ~( uint64_t( 1 ) << ( slot & 63 ) );
+      }
+
+      hw_time = ( hw_time & ~int64_t( HW_SLOTS - 1 ) ) | slot;
+      return e;
+    }
+
+    // Level 0 is empty, find the earliest occupied slot on the higher levels,
+    // advance wheel time to its start and cascade its events downwards. All
+    // lower levels are empty at this point, so insertion order is preserved.
+    bool cascaded = false;
+    for ( unsigned level = 1; level < HW_LEVELS && !cascaded; level++ )
+    {
+      for ( unsigned w = 0; w < words; w++ )
+      {
+        uint64_t& occupied = hw_occupied[ level * words + w ];
+        if ( !occupied )
+          continue;
+
+        unsigned slot  = w * 64 + lowest_bit( occupied );
+        unsigned index = level * HW_SLOTS + slot;
+        occupied &= ~( uint64_t( 1 ) << ( slot & 63 ) );
+
+        unsigned shift = HW_SHIFT * level;
+        int64_t upper_mask = ~( ( int64_t( 1 ) << ( shift + HW_SHIFT ) ) - 1 );
+        hw_time = ( hw_time & upper_mask ) | ( int64_t( slot ) << shift );
+
+        event_t* e = hw_head[ index ];
+        hw_head[ index ] = hw_tail[ index ] = nullptr;
+        while ( e )
+        {
+          event_t* next = e->next;
+          insert_hierarchical( e );
+          e = next;
+        }
+
+        cascaded = true;
+        break;
+      }
+    }
+
+    if ( !cascaded )
+    {
+      assert( false && "Hierarchical timing wheel empty with events remaining" );
+      return nullptr;
+    }
+  }
+}
+
+// event_manager_t::queue_name ==============================================
+
+const char* event_manager_t::queue_name() const
+{
+  switch ( queue_type )
+  {
+    case QUEUE_HIERARCHICAL:
+      return "hierarchical";
+    default:
+      return "wheel";
+  }
+}
+
 // event_manager_t::reset ===================================================
 
 void event_manager_t::reset()
@@ -444,6 +671,7 @@ void event_manager_t::reset()
   events_remaining = 0;
   events_processed = 0;
   timing_slice     = 0;
+  hw_time          = 0;
   global_event_id  = 0;
   canceled         = false;
   current_time     = timespan_t::zero();
@@ -459,9 +687,7 @@ void event_manager_t::merge( event_manager_t& other )
 #ifdef EVENT_QUEUE_DEBUG
   events_traversed += other.events_traversed;
   events_added += other.events_added;
-  n_allocated_events += other.n_allocated_events;
   n_end_insert += other.n_end_insert;
-  n_requested_events += other.n_requested_events;
   if ( other.max_queue_depth > max_queue_depth )
   {
     max_queue_depth = other.max_queue_depth;
@@ -480,10 +706,11 @@ void event_manager_t::merge( event_manager_t& other )
     event_queue_depth_samples[ i ].second +=
         other.event_queue_depth_samples[ i ].second;
   }
-  for ( size_t i = 0; i < other.event_requested_size_count.size(); ++i )
+#endif
+
+  for ( size_t i = 0; i < event_size_classes.size(); ++i )
   {
-    event_requested_size_count[ i ] += other.event_requested_size_count[ i ];
+    event_size_classes[ i ].requested += other.event_size_classes[ i ].requested;
+    event_size_classes[ i ].allocated += other.event_size_classes[ i ].allocated;
   }
-
-#endif
 }
@@ -15,23 +15,37 @@ namespace
 const bool EXPRESSION_DEBUG = false;
 // Unary Operators ==========================================================
 
-template <class F>
-class expr_unary_t : public expr_t
+class unary_base_t : public expr_t
 {
+public:
   expr_t* input;
 
-public:
-  expr_unary_t( const std::string& n, token_e o, expr_t* i )
+  unary_base_t( const std::string& n, token_e o, expr_t* i )
     : expr_t( n, o ), input( i )
   {
     assert( input );
   }
 
-  ~expr_unary_t()
+  ~unary_base_t()
   {
     delete input;
   }
 
+  bool dependencies( expr_dependencies_t& deps ) override
+  {
+    return input->dependencies( deps );
+  }
+};
+
+template <class F>
+class expr_unary_t : public unary_base_t
+{
+public:
+  expr_unary_t( const std::string& n, token_e o, expr_t* i )
+    : unary_base_t( n, o, i )
+  {
+  }
+
   double evaluate() override  // override
   {
     return F()( input->eval() );
@@ -128,6 +142,26 @@ public:
     delete left;
     delete right;
   }
+
+  bool dependencies( expr_dependencies_t& deps ) override
+  {
+    return left->dependencies( deps ) && right->dependencies( deps );
+  }
+
+protected:
+  // Dependencies of a short-circuiting operator. If the left operand has the deciding value
+  // ( false for and, true for or ), it determines the result on its own and the right operand is
+  // not tracked, as it is not evaluated either.
+  bool logical_dependencies( expr_dependencies_t& deps, bool decider )
+  {
+    if ( !left->dependencies( deps ) )
+      return false;
+
+    if ( ( left->eval() != 0 ) == decider )
+      return true;
+
+    return right->dependencies( deps );
+  }
 };
 
 class logical_and_t : public binary_base_t
@@ -142,6 +176,11 @@ public:
   {
     return left->eval() && right->eval();
   }
+
+  bool dependencies( expr_dependencies_t& deps ) override
+  {
+    return logical_dependencies( deps, false );
+  }
 };
 
 class logical_or_t : public binary_base_t
@@ -156,6 +195,11 @@ public:
   {
     return left->eval() || right->eval();
   }
+
+  bool dependencies( expr_dependencies_t& deps ) override
+  {
+    return logical_dependencies( deps, true );
+  }
 };
 
 class logical_xor_t : public binary_base_t
@@ -738,6 +782,10 @@ public:
         {
           return F<double>()( left, right->eval() );
         }
+        bool dependencies( expr_dependencies_t& deps ) override
+        {
+          return right->dependencies( deps );
+        }
         ~left_reduced_t()
         { delete right; }
       };
@@ -765,6 +813,10 @@ public:
         {
           return F<double>()( left->eval(), right );
         }
+        bool dependencies( expr_dependencies_t& deps ) override
+        {
+          return left->dependencies( deps );
+        }
         ~right_reduced_t()
         { delete left; }
       };
@@ -830,8 +882,489 @@ expr_t* select_analyze_binary( const std::string& name, token_e op,
   }
 }
 
+// Compiled Expressions =====================================================
+
+// Flat bytecode program for an (optimized) expression tree. Operators are interpreted by a single
+// loop over an operand stack, leaf expressions (action, buff, etc. expressions) are still evaluated
+// through their virtual evaluate(). The compiled expression owns the original tree, to keep the
+// leaves alive. Evaluation uses a stack local to the call, so leaves may evaluate the same
+// compiled expression recursively.
+class compiled_expr_t : public expr_t
+{
+public:
+  // Maximum operand stack depth of a compiled program
+  static const size_t MAX_STACK = 32;
+
+  // Smaller trees are evaluated faster by the tree evaluator, and are not compiled
+  static const size_t MIN_LEAVES = 6;
+
+  enum opcode_e : uint8_t
+  {
+    OP_CONST,   // Push constants[ arg ]
+    OP_EXPR,    // Push leaves[ arg ] -> eval()
+    OP_NEG,
+    OP_NOT,
+    OP_ABS,
+    OP_FLOOR,
+    OP_CEIL,
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV,
+    OP_MAX,
+    OP_MIN,
+    OP_EQ,
+    OP_NOTEQ,
+    OP_LT,
+    OP_LTEQ,
+    OP_GT,
+    OP_GTEQ,
+    OP_XOR,
+    OP_AND,     // Short-circuit: if top is false, jump to arg (result false), otherwise pop
+    OP_OR,      // Short-circuit: if top is true, set it to 1 and jump to arg, otherwise pop
+    OP_BOOL     // Convert top to 0/1
+  };
+
+  // Source of the right-hand operand of a binary instruction. Constant and leaf operands are read
+  // directly from the instruction (register style) instead of being pushed on the stack first.
+  enum operand_e : uint8_t
+  {
+    SRC_STACK,
+    SRC_CONST,
+    SRC_EXPR
+  };
+
+  struct instruction_t
+  {
+    opcode_e op;
+    operand_e src;
+    uint32_t arg;
+  };
+
+private:
+  expr_t* root;
+  std::vector<instruction_t> code;
+  std::vector<double> constants;
+  std::vector<expr_t*> leaves;
+  size_t depth, max_depth;
+
+  void emit( opcode_e op, uint32_t arg = 0, operand_e src = SRC_STACK )
+  {
+    code.push_back( instruction_t{ op, src, arg } );
+  }
+
+  // Emit a binary instruction, folding a constant or leaf right operand into the instruction
+  void emit_binary( opcode_e op, expr_t* right )
+  {
+    double value;
+    if ( constant_value( right, value ) )
+    {
+      emit( op, as<uint32_t>( constants.size() ), SRC_CONST );
+      constants.push_back( value );
+    }
+    else if ( is_leaf( right ) )
+    {
+      emit( op, as<uint32_t>( leaves.size() ), SRC_EXPR );
+      leaves.push_back( right );
+    }
+    else
+    {
+      compile( right );
+      emit( op );
+      pop();
+    }
+  }
+
+  void push( size_t n = 1 )
+  {
+    depth += n;
+    max_depth = std::max( max_depth, depth );
+  }
+
+  void pop( size_t n = 1 )
+  {
+    depth -= n;
+  }
+
+  static opcode_e unary_opcode( token_e op )
+  {
+    switch ( op )
+    {
+      case TOK_MINUS: return OP_NEG;
+      case TOK_NOT:   return OP_NOT;
+      case TOK_ABS:   return OP_ABS;
+      case TOK_FLOOR: return OP_FLOOR;
+      case TOK_CEIL:  return OP_CEIL;
+      default:        return OP_EXPR;
+    }
+  }
+
+  static opcode_e binary_opcode( token_e op )
+  {
+    switch ( op )
+    {
+      case TOK_ADD:   return OP_ADD;
+      case TOK_SUB:   return OP_SUB;
+      case TOK_MULT:  return OP_MUL;
+      case TOK_DIV:   return OP_DIV;
+      case TOK_MAX:   return OP_MAX;
+      case TOK_MIN:   return OP_MIN;
+      case TOK_EQ:    return OP_EQ;
+      case TOK_NOTEQ: return OP_NOTEQ;
+      case TOK_LT:    return OP_LT;
+      case TOK_LTEQ:  return OP_LTEQ;
+      case TOK_GT:    return OP_GT;
+      case TOK_GTEQ:  return OP_GTEQ;
+      case TOK_XOR:   return OP_XOR;
+      case TOK_AND:   return OP_AND;
+      case TOK_OR:    return OP_OR;
+      default:        return OP_EXPR;
+    }
+  }
+
+  static double apply( opcode_e op, double l, double r = 0 )
+  {
+    switch ( op )
+    {
+      case OP_NEG:   return -l;
+      case OP_NOT:   return ! l;
+      case OP_ABS:   return std::fabs( l );
+      case OP_FLOOR: return std::floor( l );
+      case OP_CEIL:  return std::ceil( l );
+      case OP_ADD:   return l + r;
+      case OP_SUB:   return l - r;
+      case OP_MUL:   return l * r;
+      case OP_DIV:   return l / r;
+      case OP_MAX:   return std::max( l, r );
+      case OP_MIN:   return std::min( l, r );
+      case OP_EQ:    return l == r;
+      case OP_NOTEQ: return l != r;
+      case OP_LT:    return l < r;
+      case OP_LTEQ:  return l <= r;
+      case OP_GT:    return l > r;
+      case OP_GTEQ:  return l >= r;
+      case OP_XOR:   return bool( l != 0 ) != bool( r != 0 );
+      case OP_AND:   return l && r;
+      case OP_OR:    return l || r;
+      default:       assert( false ); return 0;
+    }
+  }
+
+public:
+  // Constant folding. Returns true and the value if the (sub)tree evaluates to a constant.
+  static bool constant_value( expr_t* e, double& v )
+  {
+    if ( e -> is_constant( &v ) )
+    {
+      return true;
+    }
+
+    if ( auto unary = dynamic_cast<unary_base_t*>( e ) )
+    {
+      auto op = unary_opcode( e -> op_ );
+      double input;
+      if ( op != OP_EXPR && constant_value( unary -> input, input ) )
+      {
+        v = apply( op, input );
+        return true;
+      }
+    }
+    else if ( auto binary = dynamic_cast<binary_base_t*>( e ) )
+    {
+      auto op = binary_opcode( e -> op_ );
+      if ( op == OP_EXPR )
+      {
+        return false;
+      }
+
+      double l, r;
+      bool left_constant = constant_value( binary -> left, l );
+      // Short-circuiting operators with a deciding constant left side
+      if ( left_constant && ( ( op == OP_AND && l == 0 ) || ( op == OP_OR && l != 0 ) ) )
+      {
+        v = op == OP_OR;
+        return true;
+      }
+
+      if ( left_constant && constant_value( binary -> right, r ) )
+      {
+        v = apply( op, l, r );
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  explicit compiled_expr_t( expr_t* e ) :
+    expr_t( e -> name() ), root( e ), depth( 0 ), max_depth( 0 )
+  {
+    compile( e );
+    assert( depth == 1 );
+  }
+
+  ~compiled_expr_t()
+  {
+    delete root;
+  }
+
+  // Give up ownership of the original tree
+  expr_t* release()
+  {
+    auto e = root;
+    root = nullptr;
+    return e;
+  }
+
+  size_t stack_depth() const
+  { return max_depth; }
+
+  static bool is_leaf( expr_t* e )
+  {
+    return dynamic_cast<unary_base_t*>( e ) == nullptr && dynamic_cast<binary_base_t*>( e ) == nullptr;
+  }
+
+  static size_t leaf_count( expr_t* e )
+  {
+    if ( auto unary = dynamic_cast<unary_base_t*>( e ) )
+    {
+      return leaf_count( unary -> input );
+    }
+    else if ( auto binary = dynamic_cast<binary_base_t*>( e ) )
+    {
+      return leaf_count( binary -> left ) + leaf_count( binary -> right );
+    }
+
+    return 1;
+  }
+
+  static bool is_boolean( opcode_e op )
+  {
+    return op == OP_NOT || ( op >= OP_EQ && op <= OP_BOOL );
+  }
+
+  // Emit code for the (sub)tree e, leaving its value on top of the stack. Returns true if the
+  // emitted code always produces 0 or 1.
+  bool compile( expr_t* e )
+  {
+    double value;
+    if ( constant_value( e, value ) )
+    {
+      emit( OP_CONST, as<uint32_t>( constants.size() ) );
+      constants.push_back( value );
+      push();
+      return value == 0 || value == 1;
+    }
+
+    auto unary = dynamic_cast<unary_base_t*>( e );
+    auto binary = dynamic_cast<binary_base_t*>( e );
+    opcode_e op = unary ? unary_opcode( e -> op_ ) : binary ? binary_opcode( e -> op_ ) : OP_EXPR;
+
+    if ( op == OP_EXPR )
+    {
+      emit( OP_EXPR, as<uint32_t>( leaves.size() ) );
+      leaves.push_back( e );
+      push();
+      return false;
+    }
+    else if ( unary )
+    {
+      compile( unary -> input );
+      emit( op );
+    }
+    else if ( op == OP_AND || op == OP_OR )
+    {
+      double l;
+      bool left_constant = constant_value( binary -> left, l );
+      // Leaf or constant right side is evaluated in place by the instruction, which only touches it
+      // when the left side does not decide the result.
+      if ( ! left_constant && ( is_leaf( binary -> right ) || constant_value( binary -> right, value ) ) )
+      {
+        compile( binary -> left );
+        emit_binary( op, binary -> right );
+        return true;
+      }
+
+      // Constant left side is non-deciding (otherwise the whole subtree would be constant), the
+      // result is the right side as a boolean
+      size_t jump = 0;
+      if ( ! left_constant )
+      {
+        compile( binary -> left );
+        jump = code.size();
+        emit( op );
+        pop();
+      }
+
+      if ( ! compile( binary -> right ) )
+      {
+        emit( OP_BOOL );
+      }
+
+      if ( ! left_constant )
+      {
+        code[ jump ].arg = as<uint32_t>( code.size() );
+      }
+    }
+    else
+    {
+      compile( binary -> left );
+      emit_binary( op, binary -> right );
+    }
+
+    return is_boolean( op );
+  }
+
+  size_t size() const
+  { return code.size(); }
+
+  // The source tree reads the same state as the program
+  bool dependencies( expr_dependencies_t& deps ) override
+  {
+    return root->dependencies( deps );
+  }
+
+  bool is_constant( double* v ) override
+  {
+    if ( code.size() == 1 && code.front().op == OP_CONST )
+    {
+      *v = constants.front();
+      return true;
+    }
+
+    return false;
+  }
+
+  // Right-hand operand of a binary instruction. Stack operands are popped before the left-hand
+  // side is read, so sp[ -1 ] refers to the left operand afterwards.
+  double operand( const instruction_t* pc, double*& sp ) const
+  {
+    switch ( pc -> src )
+    {
+      case SRC_CONST: return constants[ pc -> arg ];
+      case SRC_EXPR:  return leaves[ pc -> arg ] -> eval();
+      default:        return *--sp;
+    }
+  }
+
+  double evaluate() override
+  {
+    double stack[ MAX_STACK ];
+    double* sp = stack;
+    double r;
+    const instruction_t* begin = code.data();
+    const instruction_t* end = begin + code.size();
+
+    for ( const instruction_t* pc = begin; pc < end; ++pc )
+    {
+      switch ( pc -> op )
+      {
+        case OP_CONST: *sp++ = constants[ pc -> arg ]; break;
+        case OP_EXPR:  *sp++ = leaves[ pc -> arg ] -> eval(); break;
+        case OP_NEG:   sp[ -1 ] = -sp[ -1 ]; break;
+        case OP_NOT:   sp[ -1 ] = ! sp[ -1 ]; break;
+        case OP_ABS:   sp[ -1 ] = std::fabs( sp[ -1 ] ); break;
+        case OP_FLOOR: sp[ -1 ] = std::floor( sp[ -1 ] ); break;
+        case OP_CEIL:  sp[ -1 ] = std::ceil( sp[ -1 ] ); break;
+        case OP_ADD:   r = operand( pc, sp ); sp[ -1 ] = sp[ -1 ] + r; break;
+        case OP_SUB:   r = operand( pc, sp ); sp[ -1 ] = sp[ -1 ] - r; break;
+        case OP_MUL:   r = operand( pc, sp ); sp[ -1 ] = sp[ -1 ] * r; break;
+        case OP_DIV:   r = operand( pc, sp ); sp[ -1 ] = sp[ -1 ] / r; break;
+        case OP_MAX:   r = operand( pc, sp ); sp[ -1 ] = std::max( sp[ -1 ], r ); break;
+        case OP_MIN:   r = operand( pc, sp ); sp[ -1 ] = std::min( sp[ -1 ], r ); break;
+        case OP_EQ:    r = operand( pc, sp ); sp[ -1 ] = sp[ -1 ] == r; break;
+        case OP_NOTEQ: r = operand( pc, sp ); sp[ -1 ] = sp[ -1 ] != r; break;
+        case OP_LT:    r = operand( pc, sp ); sp[ -1 ] = sp[ -1 ] < r; break;
+        case OP_LTEQ:  r = operand( pc, sp ); sp[ -1 ] = sp[ -1 ] <= r; break;
+        case OP_GT:    r = operand( pc, sp ); sp[ -1 ] = sp[ -1 ] > r; break;
+        case OP_GTEQ:  r = operand( pc, sp ); sp[ -1 ] = sp[ -1 ] >= r; break;
+        case OP_XOR:   r = operand( pc, sp ); sp[ -1 ] = bool( sp[ -1 ] != 0 ) != bool( r != 0 ); break;
+        case OP_AND:
+          if ( sp[ -1 ] == 0 )
+          {
+            sp[ -1 ] = 0;
+            if ( pc -> src == SRC_STACK )
+            {
+              pc = begin + pc -> arg - 1;
+            }
+          }
+          else if ( pc -> src == SRC_STACK )
+          {
+            --sp;
+          }
+          else
+          {
+            sp[ -1 ] = operand( pc, sp ) != 0;
+          }
+          break;
+        case OP_OR:
+          if ( sp[ -1 ] != 0 )
+          {
+            sp[ -1 ] = 1;
+            if ( pc -> src == SRC_STACK )
+            {
+              pc = begin + pc -> arg - 1;
+            }
+          }
+          else if ( pc -> src == SRC_STACK )
+          {
+            --sp;
+          }
+          else
+          {
+            sp[ -1 ] = operand( pc, sp ) != 0;
+          }
+          break;
+        case OP_BOOL:  sp[ -1 ] = sp[ -1 ] != 0; break;
+      }
+    }
+
+    assert( sp == stack + 1 );
+    return sp[ -1 ];
+  }
+};
+
 }  // UNNAMED NAMESPACE ====================================================
 
+// Lower an expression tree into a flat bytecode program. Takes ownership of the tree. Constant
+// (sub)trees are folded. Leaf or constant expressions, trees with fewer than
+// compiled_expr_t::MIN_LEAVES leaves, and trees too deep for the operand stack are returned as is.
+expr_t* compile( expr_t* e )
+{
+  if ( e == nullptr )
+  {
+    return e;
+  }
+
+  double value;
+  if ( compiled_expr_t::constant_value( e, value ) )
+  {
+    if ( e -> is_constant( &value ) )
+    {
+      return e;
+    }
+
+    std::string new_name = std::string( "const_compiled('" ) + e -> name() + "')";
+    delete e;
+    return new const_expr_t( new_name, value );
+  }
+
+  if ( compiled_expr_t::leaf_count( e ) < compiled_expr_t::MIN_LEAVES )
+  {
+    return e;
+  }
+
+  auto compiled = new compiled_expr_t( e );
+  if ( compiled -> stack_depth() > compiled_expr_t::MAX_STACK )
+  {
+    compiled -> release();
+    delete compiled;
+    return e;
+  }
+
+  return compiled;
+}
+
 // precedence ===============================================================
 
 int precedence( token_e expr_token_type )
@@ -1430,7 +1963,13 @@ int main( int argc, char** argv )
         printf( "%f\n", expr->eval() );
       }
       else
+      {
+        time_test( expr, n_evals );
+        // Compare against the bytecode program of the same tree
+        expr = expression::compile( expr );
         time_test( expr, n_evals );
+      }
+      delete expr;
     }
   }
 
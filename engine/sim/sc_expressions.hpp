@@ -14,6 +14,7 @@
 struct action_t;
 struct sim_t;
 struct player_t;
+struct expr_t;
 
 // Expressions ==============================================================
 
@@ -69,8 +70,47 @@ std::vector<expr_token_t> parse_tokens( action_t* action,
 void print_tokens( std::vector<expr_token_t>& tokens, sim_t* sim );
 void convert_to_unary( std::vector<expr_token_t>& tokens );
 bool convert_to_rpn( std::vector<expr_token_t>& tokens );
+expr_t* compile( expr_t* );
 }
 
+/// State an expression value is derived from, see expr_t::dependencies()
+struct expr_dependencies_t
+{
+  /// Version counters of the state read, each bumped on every change of that state
+  std::vector<const uint64_t*> versions;
+  /// State read directly, compared by value
+  std::vector<const double*> values;
+  /// Time after which the value may change without any of the above changing
+  timespan_t valid_until;
+
+  expr_dependencies_t() : valid_until( timespan_t::max() )
+  {
+  }
+
+  void clear()
+  {
+    versions.clear();
+    values.clear();
+    valid_until = timespan_t::max();
+  }
+
+  void add( const uint64_t& version )
+  {
+    versions.push_back( &version );
+  }
+
+  void add( const double& value )
+  {
+    values.push_back( &value );
+  }
+
+  void expires( timespan_t t )
+  {
+    if ( t < valid_until )
+      valid_until = t;
+  }
+};
+
 /// Action expression
 struct expr_t
 {
@@ -153,6 +193,15 @@ public:
     return false;
   }
 
+  /**
+   * Collect the state the current value is derived from. Returns false if the value depends on
+   * state that is not tracked (the default), in which case the value cannot be reused.
+   */
+  virtual bool dependencies( expr_dependencies_t& )
+  {
+    return false;
+  }
+
   expression::token_e op_;
 
 private:
@@ -184,6 +233,11 @@ public:
     *v = value;
     return true;
   }
+
+  bool dependencies( expr_dependencies_t& ) override
+  {
+    return true;
+  }
 };
 
 // Reference Expression - ref_expr_t
@@ -431,6 +431,8 @@ protected:
           stream << name() << entry.first << "="<< entry.second << "\n";
      return stream;
   }
+  bool prefix_match() const override
+  { return true; }
   opts::map_t& _ref;
 };
 
@@ -497,6 +499,9 @@ protected:
     return stream;
   }
 
+  bool prefix_match() const override
+  { return true; }
+
   opts::map_list_t& _ref;
 };
 
@@ -578,6 +583,72 @@ bool opts::parse( sim_t*                 sim,
 
 // option_t::parse ==========================================================
 
+bool opts::parse( sim_t*                 sim,
+                  const std::vector<std::unique_ptr<option_t>>& options,
+                  option_index_t&        index,
+                  const std::string&     name,
+                  const std::string&     value )
+{
+  return index.parse( sim, options, name, value );
+}
+
+// option_index_t::update ===================================================
+
+void opts::option_index_t::update( const std::vector<std::unique_ptr<option_t>>& options )
+{
+  const option_t* front = options.empty() ? nullptr : options.front().get();
+  if ( _size == options.size() && _front == front )
+    return;
+
+  _exact.clear();
+  _prefix.clear();
+
+  for ( size_t i = 0; i < options.size(); ++i )
+  {
+    if ( options[ i ] -> prefix_match() )
+      _prefix.push_back( i );
+    else
+      _exact[ options[ i ] -> name() ].push_back( i );
+  }
+
+  _size = options.size();
+  _front = front;
+}
+
+// option_index_t::parse ====================================================
+
+bool opts::option_index_t::parse( sim_t*                 sim,
+                                  const std::vector<std::unique_ptr<option_t>>& options,
+                                  const std::string&     name,
+                                  const std::string&     value )
+{
+  update( options );
+
+  static const std::vector<size_t> no_candidates;
+  auto it = _exact.find( name );
+  const auto& exact = it != _exact.end() ? it -> second : no_candidates;
+
+  // Walk both candidate lists in list order
+  size_t e = 0, p = 0;
+  while ( e < exact.size() || p < _prefix.size() )
+  {
+    size_t i;
+    if ( p == _prefix.size() || ( e < exact.size() && exact[ e ] < _prefix[ p ] ) )
+      i = exact[ e++ ];
+    else
+      i = _prefix[ p++ ];
+
+    if ( options[ i ] -> parse_option( sim, name, value ) )
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// option_t::parse ==========================================================
+
 void opts::parse( sim_t*                 sim,
     const std::string&            context,
     const std::vector<std::unique_ptr<option_t>>& options,
@@ -44,6 +44,9 @@ public:
   { return _name; }
   std::ostream& print_option( std::ostream& stream ) const
   { return print( stream ); }
+  // Options matching on a name prefix (eg. maps) instead of their exact name
+  virtual bool prefix_match() const
+  { return false; }
 protected:
   virtual bool parse( sim_t*, const std::string& name, const std::string& value ) const = 0;
   virtual std::ostream& print( std::ostream& stream ) const = 0;
@@ -58,7 +61,28 @@ typedef std::unordered_map<std::string, std::string> map_t;
 typedef std::unordered_map<std::string, std::vector<std::string>> map_list_t;
 typedef std::function<bool(sim_t*,const std::string&, const std::string&)> function_t;
 typedef std::vector<std::string> list_t;
+
+/* Name lookup for an option list. Exact-name options are hashed by name, prefix options are kept
+ * in a fallback list. Candidates are tried in list order, so the first matching option wins just
+ * like with a linear scan. The index rebuilds itself when the option list changes.
+ */
+class option_index_t
+{
+  std::unordered_map<std::string, std::vector<size_t>> _exact;
+  std::vector<size_t> _prefix;
+  size_t _size;
+  const option_t* _front;
+
+  void update( const std::vector<std::unique_ptr<option_t>>& options );
+public:
+  option_index_t() : _size( 0 ), _front( nullptr )
+  { }
+
+  bool parse( sim_t*, const std::vector<std::unique_ptr<option_t>>&, const std::string& name, const std::string& value );
+};
+
 bool parse( sim_t*, const std::vector<std::unique_ptr<option_t>>&, const std::string& name, const std::string& value );
+bool parse( sim_t*, const std::vector<std::unique_ptr<option_t>>&, option_index_t&, const std::string& name, const std::string& value );
 void parse( sim_t*, const std::string& context, const std::vector<std::unique_ptr<option_t>>&, const std::string& options_str );
 void parse( sim_t*, const std::string& context, const std::vector<std::unique_ptr<option_t>>&, const std::vector<std::string>& strings );
 }
@@ -35,6 +35,123 @@ bool is_plot_stat( sim_t* sim, stat_e stat )
   return it != sim->player_no_pet_list.end();
 }
 
+/// Plot data of all players (by name) in point_sim, zeroed for players not scaling with the stat
+std::vector<plot_data_t> point_data( sim_t* sim, sim_t& point_sim, stat_e stat, double step )
+{
+  std::vector<plot_data_t> data( sim->players_by_name.size() );
+
+  for ( size_t i = 0; i < sim->players_by_name.size(); i++ )
+  {
+    player_t* p = sim->players_by_name[ i ];
+    if ( !p->scaling->scales_with[ stat ] )
+      continue;
+
+    player_t* point_p = point_sim.find_player( p->name() );
+
+    scaling_metric_data_t scaling_data =
+        point_p->scaling_for_metric( sim->scaling->scaling_metric );
+
+    data[ i ].value     = scaling_data.value;
+    data[ i ].error     = scaling_data.stddev * point_sim.confidence_estimator;
+    data[ i ].plot_step = step;
+  }
+
+  return data;
+}
+
+/// Initial plot points. Adaptive plots start from a coarse grid with at least four segments.
+std::vector<int> initial_points( int start, int end, bool adaptive )
+{
+  int stride = 1;
+  while ( adaptive && ( end - start ) / ( stride * 2 ) >= 4 )
+    stride *= 2;
+
+  std::vector<int> steps;
+  for ( int j = start; j <= end; j += stride )
+  {
+    if ( j != 0 )
+      steps.push_back( j );
+  }
+
+  if ( ( end - start ) % stride != 0 && end != 0 )
+    steps.push_back( end );
+
+  return steps;
+}
+
+/// Midpoints of the segments around every point where the plot of some player significantly bends.
+/// The deviation of a point from the straight line through its neighbours is tested against its
+/// standard error at the confidence level of the sim, Bonferroni-corrected for the number of
+/// (point, player) pairs tested in the round, so noise alone rarely refines a straight part of the
+/// curve. Straight parts of the curve are left at the coarse spacing.
+std::vector<int> refine_points( const sim_t* sim, const std::map<int, std::vector<plot_data_t>>& points )
+{
+  std::vector<std::pair<int, const std::vector<plot_data_t>*>> sorted;
+  for ( const auto& point : points )
+    sorted.push_back( std::make_pair( point.first, &point.second ) );
+
+  // Deviation and its standard error of every tested (point, player) pair
+  struct bend_t
+  {
+    size_t point;
+    double deviation, std_error;
+  };
+  std::vector<bend_t> bends;
+
+  for ( size_t m = 1; m + 1 < sorted.size(); m++ )
+  {
+    const auto& l = sorted[ m - 1 ];
+    const auto& c = sorted[ m ];
+    const auto& r = sorted[ m + 1 ];
+
+    double w_r = ( c.first - l.first ) / static_cast<double>( r.first - l.first );
+    double w_l = 1.0 - w_r;
+
+    for ( size_t i = 0; i < c.second->size(); i++ )
+    {
+      const plot_data_t& dl = ( *l.second )[ i ];
+      const plot_data_t& dc = ( *c.second )[ i ];
+      const plot_data_t& dr = ( *r.second )[ i ];
+
+      // Errors of the points are confidence interval half-widths
+      double error = std::sqrt( dc.error * dc.error + w_l * w_l * dl.error * dl.error +
+                                w_r * w_r * dr.error * dr.error );
+      if ( error <= 0 )
+        continue;
+
+      bends.push_back( { m, std::fabs( dc.value - ( w_l * dl.value + w_r * dr.value ) ),
+                         error / sim->confidence_estimator } );
+    }
+  }
+
+  if ( bends.empty() )
+    return std::vector<int>();
+
+  double alpha = ( 1.0 - sim->confidence ) / bends.size();
+  double z     = rng::stdnormal_inv( 1.0 - alpha / 2.0 );
+
+  std::vector<int> steps;
+  for ( const auto& bend : bends )
+  {
+    if ( bend.deviation <= z * bend.std_error )
+      continue;
+
+    const auto& l = sorted[ bend.point - 1 ];
+    const auto& c = sorted[ bend.point ];
+    const auto& r = sorted[ bend.point + 1 ];
+
+    if ( c.first - l.first > 1 )
+      steps.push_back( l.first + ( c.first - l.first ) / 2 );
+    if ( r.first - c.first > 1 )
+      steps.push_back( c.first + ( r.first - c.first ) / 2 );
+  }
+
+  range::sort( steps );
+  steps.erase( std::unique( steps.begin(), steps.end() ), steps.end() );
+
+  return steps;
+}
+
 }  // UNNAMED NAMESPACE ====================================================
 
 // ==========================================================================
@@ -55,7 +172,10 @@ plot_t::plot_t( sim_t* s )
     remaining_plot_stats( 0 ),
     remaining_plot_points( 0 ),
     dps_plot_positive( 0 ),
-    dps_plot_negative( 0 )
+    dps_plot_negative( 0 ),
+    dps_plot_concurrent( 0 ),
+    dps_plot_adaptive( 0 ),
+    batch( s )
 {
   create_options();
 }
@@ -153,70 +273,75 @@ void plot_t::analyze_stats()
       end   = -start;
     }
 
-    for ( int j = start; j <= end; j++ )
-    {
-      if ( sim->is_canceled() )
-        break;
-
-      std::unique_ptr<sim_t> delta_sim;
+    // Plot data of every evaluated point, the baseline sim being the zero point
+    std::map<int, std::vector<plot_data_t>> points;
+    points[ 0 ] = point_data( sim, *sim, i, 0 );
 
-      if ( j != 0 )
-      {
-        delta_sim = std::unique_ptr<sim_t>( new sim_t( sim ) );
-        if ( dps_plot_iterations > 0 )
-        {
-          delta_sim->work_queue->init( dps_plot_iterations );
-        }
-        if ( dps_plot_target_error > 0 )
-          delta_sim->target_error = dps_plot_target_error;
-        //delta_sim->enchant.add_stat( i, j * dps_plot_step );
-        delta_sim->scaling->scale_stat = i;
-        delta_sim->scaling->scale_value = j * dps_plot_step;
-        delta_sim->progress_bar.set_base( util::to_string( j * dps_plot_step ) + " " + util::stat_type_abbrev( i ) );
-        delta_sim->execute();
-        if ( dps_plot_debug )
-        {
-          sim->out_debug.raw().printf( "Stat=%s Point=%d\n",
-                                       util::stat_type_string( i ), j );
-          report::print_text( delta_sim.get(), true );
-        }
-      }
+    std::vector<int> steps = initial_points( start, end, dps_plot_adaptive != 0 );
+    while ( !steps.empty() && !sim->is_canceled() )
+    {
+      evaluate_points( i, steps, points );
+      steps = dps_plot_adaptive ? refine_points( sim, points ) : std::vector<int>();
+    }
 
-      for ( player_t* p : sim->players_by_name )
+    for ( const auto& point : points )
+    {
+      for ( size_t k = 0; k < sim->players_by_name.size(); k++ )
       {
+        player_t* p = sim->players_by_name[ k ];
         if ( !p->scaling->scales_with[ i ] )
           continue;
 
-        plot_data_t data;
-
-        if ( delta_sim )
-        {
-          player_t* delta_p = delta_sim->find_player( p->name() );
-
-          scaling_metric_data_t scaling_data =
-              delta_p->scaling_for_metric( p->sim->scaling->scaling_metric );
-
-          data.value = scaling_data.value;
-          data.error = scaling_data.stddev * delta_sim->confidence_estimator;
-        }
-        else
-        {
-          scaling_metric_data_t scaling_data =
-              p->scaling_for_metric( p->sim->scaling->scaling_metric );
-          data.value = scaling_data.value;
-          data.error = scaling_data.stddev * sim->confidence_estimator;
-        }
-        data.plot_step = j * dps_plot_step;
-        p->dps_plot_data[ i ].push_back( data );
+        p->dps_plot_data[ i ].push_back( point.second[ k ] );
       }
+    }
+
+    remaining_plot_stats--;
+  }
+}
+
+// plot_t::evaluate_points ================================================
+
+void plot_t::evaluate_points( stat_e stat, const std::vector<int>& steps,
+                              std::map<int, std::vector<plot_data_t>>& points )
+{
+  std::vector<std::vector<plot_data_t>> results( steps.size() );
+  mutex_t mutex;
+
+  sim->progress_bar.set_base( "Plot" );
+  sim->progress_bar.set_phase( util::stat_type_abbrev( stat ) );
 
-      if ( delta_sim )
+  batch.execute( steps.size(), dps_plot_concurrent ? 0 : 1,
+    [ this, stat, &steps ]( size_t idx, sim_control_t* control ) {
+      sim_t* delta_sim = new sim_t( sim, 0, control );
+      if ( dps_plot_iterations > 0 )
       {
-        remaining_plot_points--;
+        delta_sim->work_queue->init( dps_plot_iterations );
       }
-    }
+      if ( dps_plot_target_error > 0 )
+        delta_sim->target_error = dps_plot_target_error;
+      delta_sim->scaling->scale_stat = stat;
+      delta_sim->scaling->scale_value = steps[ idx ] * dps_plot_step;
+      delta_sim->progress_bar.set_base( util::to_string( steps[ idx ] * dps_plot_step ) + " " + util::stat_type_abbrev( stat ) );
+      return delta_sim;
+    },
+    [ this, stat, &steps, &results, &mutex ]( size_t idx, std::unique_ptr<sim_t>& delta_sim ) {
+      results[ idx ] = point_data( sim, *delta_sim, stat, steps[ idx ] * dps_plot_step );
+
+      AUTO_LOCK( mutex );
+      if ( dps_plot_debug )
+      {
+        sim->out_debug.raw().printf( "Stat=%s Point=%d\n",
+                                     util::stat_type_string( stat ), steps[ idx ] );
+        report::print_text( delta_sim.get(), true );
+      }
+      remaining_plot_points--;
+    } );
 
-    remaining_plot_stats--;
+  for ( size_t idx = 0; idx < steps.size(); idx++ )
+  {
+    if ( !results[ idx ].empty() )
+      points[ steps[ idx ] ] = std::move( results[ idx ] );
   }
 }
 
@@ -273,4 +398,6 @@ void plot_t::create_options()
   sim->add_option( opt_bool( "dps_plot_debug", dps_plot_debug ) );
   sim->add_option( opt_bool( "dps_plot_positive", dps_plot_positive ) );
   sim->add_option( opt_bool( "dps_plot_negative", dps_plot_negative ) );
+  sim->add_option( opt_bool( "dps_plot_concurrent", dps_plot_concurrent ) );
+  sim->add_option( opt_bool( "dps_plot_adaptive", dps_plot_adaptive ) );
 }
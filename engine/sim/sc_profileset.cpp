@@ -69,14 +69,85 @@ std::string format_time( double seconds, bool milliseconds = true )
   return s.str();
 }
 
-// Deallocating profile_sim is the responsibility of the caller (i.e., profileset driver or
-// worker_t)
-void simulate_profileset( sim_t* parent, profile_set_t& set, sim_t*& profile_sim )
+// Metrics where a lower value is a better result
+bool lower_is_better( scale_metric_e metric )
+{
+  switch ( metric )
+  {
+    case SCALE_METRIC_DTPS:
+    case SCALE_METRIC_DMG_TAKEN:
+    case SCALE_METRIC_TMI:
+    case SCALE_METRIC_ETMI:
+    case SCALE_METRIC_DEATHS:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Pairwise (Chan et al.) combination of the mean, variance and range of two disjoint samples of
+// the same metric. Median and quartiles cannot be combined, and are kept as is.
+void merge_result( profile_result_t& into, const profile_result_t& from )
+{
+  if ( from.iterations() == 0 )
+  {
+    return;
+  }
+
+  if ( into.iterations() == 0 )
+  {
+    into = from;
+    return;
+  }
+
+  double n = as<double>( into.iterations() + from.iterations() );
+  double delta = from.mean() - into.mean();
+  double weight = from.iterations() / n;
+  double m2 = into.stddev() * into.stddev() * into.iterations() +
+              from.stddev() * from.stddev() * from.iterations() +
+              delta * delta * into.iterations() * weight;
+
+  into.mean( into.mean() + delta * weight )
+      .stddev( std::sqrt( m2 / n ) )
+      .min( std::min( into.min(), from.min() ) )
+      .max( std::max( into.max(), from.max() ) )
+      .iterations( into.iterations() + from.iterations() );
+}
+
+// Profileset sim settings that need to be in place before the sim is initialized
+void setup_profileset_sim( sim_t* profile_sim )
 {
   // Reset random seed for the profileset sims
   profile_sim -> seed = 0;
   profile_sim -> profileset_enabled = true;
   profile_sim -> report_details = 0;
+}
+
+// Deallocating profile_sim is the responsibility of the caller (i.e., profileset driver or
+// worker_t). A non-zero iterations simulates a fixed-length racing screening round, which does not
+// produce reports or output data, and keeps the profileset options around for the next round. The
+// full run of a profileset that survived racing only simulates the remaining iterations, and
+// folds the screening samples into its results.
+void simulate_profileset( sim_t* parent, profile_set_t& set, sim_t*& profile_sim, int iterations )
+{
+  // Prepared profileset sims have been set up before initialization
+  if ( ! profile_sim -> initialized )
+  {
+    setup_profileset_sim( profile_sim );
+  }
+
+  if ( iterations > 0 )
+  {
+    profile_sim -> iterations = iterations;
+    profile_sim -> target_error = 0;
+    profile_sim -> work_queue -> init( iterations );
+  }
+  else if ( set.race_iterations() > 0 && profile_sim -> target_error <= 0 )
+  {
+    auto remaining = profile_sim -> iterations - as<int>( set.race_iterations() );
+    profile_sim -> iterations = std::max( remaining, 1 );
+    profile_sim -> work_queue -> init( profile_sim -> iterations );
+  }
   if ( parent -> profileset_work_threads > 0 )
   {
     profile_sim -> threads = parent -> profileset_work_threads;
@@ -86,7 +157,7 @@ void simulate_profileset( sim_t* parent, profile_set_t& set, sim_t*& profile_sim
   }
   else
   {
-    profile_sim -> progress_bar.set_base( "Profileset" );
+    profile_sim -> progress_bar.set_base( iterations > 0 ? "Profileset race" : "Profileset" );
     profile_sim -> progress_bar.set_phase( set.name() );
   }
 
@@ -95,7 +166,7 @@ void simulate_profileset( sim_t* parent, profile_set_t& set, sim_t*& profile_sim
   {
     profile_sim -> progress_bar.restart();
 
-    if ( set.has_output() )
+    if ( set.has_output() && iterations == 0 )
     {
       report::print_suite( profile_sim );
     }
@@ -109,11 +180,13 @@ void simulate_profileset( sim_t* parent, profile_set_t& set, sim_t*& profile_sim
   const auto player = profile_sim -> player_no_pet_list.data().front();
   auto progress = profile_sim -> progress( nullptr, 0 );
 
+  // Screening round results are only accumulated for racing, the profileset results hold the full
+  // run
   range::for_each( parent -> profileset_metric, [ & ]( scale_metric_e metric ) {
     auto data = metric_data( player, metric );
 
-    set.result( metric )
-      .min( data.min )
+    profile_result_t result( metric );
+    result.min( data.min )
       .first_quartile( data.first_quartile )
       .median( data.median )
       .mean( data.mean )
@@ -121,8 +194,24 @@ void simulate_profileset( sim_t* parent, profile_set_t& set, sim_t*& profile_sim
       .max( data.max )
       .stddev( data.std_dev )
       .iterations( progress.current_iterations );
+
+    if ( iterations > 0 )
+    {
+      set.race_add( result );
+    }
+    else
+    {
+      set.result( metric ) = result;
+    }
   } );
 
+  if ( iterations > 0 )
+  {
+    return;
+  }
+
+  set.race_fold();
+
   if ( ! parent -> profileset_output_data.empty() )
   {
     const auto parent_player = parent -> player_no_pet_list.data().front();
@@ -134,12 +223,27 @@ void simulate_profileset( sim_t* parent, profile_set_t& set, sim_t*& profile_sim
   set.cleanup_options();
 }
 
+// Profilesets are ranked by the median of the primary metric. With racing, the mean and standard
+// deviation include the screening samples, while the median and quartiles come from a single run
+// (the full run, or the first screening round of an eliminated profileset), so profilesets are
+// ranked by the mean instead.
+double rank_value( const sim_t& sim, const statistical_data_t& data )
+{
+  return sim.profileset_race ? data.mean : data.median;
+}
+
+const char* rank_name( const sim_t& sim )
+{
+  return sim.profileset_race ? "mean" : "median";
+}
+
 void insert_data( highchart::bar_chart_t&   chart,
+                  const sim_t&              sim,
                   const std::string&        name,
                   const color::rgb&         c,
                   const statistical_data_t& data,
                   bool                      baseline,
-                  double                    baseline_median )
+                  double                    baseline_value )
 {
   js::sc_js_t entry;
 
@@ -151,8 +255,8 @@ void insert_data( highchart::bar_chart_t&   chart,
   }
 
   entry.set( "name", name );
-  entry.set( "reldiff", baseline_median > 0 ? (data.median / baseline_median - 1.0) * 100 : 0);
-  entry.set( "y", util::round( data.median ) );
+  entry.set( "reldiff", baseline_value > 0 ? (rank_value( sim, data ) / baseline_value - 1.0) * 100 : 0);
+  entry.set( "y", util::round( rank_value( sim, data ) ) );
 
   chart.add( "series.0.data", entry );
 
@@ -273,8 +377,49 @@ sim_control_t* profilesets_t::create_sim_options( const sim_control_t*
 }
 
 profile_set_t::profile_set_t( const std::string& name, sim_control_t* opts, bool has_output ) :
-  m_name( name ), m_options( opts ), m_has_output( has_output ), m_output_data( nullptr )
+  m_name( name ), m_options( opts ), m_has_output( has_output ), m_output_data( nullptr ),
+  m_eliminated( false ), m_sim( nullptr )
+{
+}
+
+void profile_set_t::race_add( const profile_result_t& result )
+{
+  auto it = range::find_if( m_race_results, [ &result ]( const profile_result_t& r ) {
+    return r.metric() == result.metric();
+  } );
+
+  if ( it == m_race_results.end() )
+  {
+    m_race_results.push_back( profile_result_t( result.metric() ) );
+    it = m_race_results.end() - 1;
+  }
+
+  merge_result( *it, result );
+}
+
+void profile_set_t::race_fold()
+{
+  range::for_each( m_race_results, [ this ]( const profile_result_t& r ) {
+    merge_result( result( r.metric() ), r );
+  } );
+
+  m_race_results.clear();
+}
+
+size_t profile_set_t::race_iterations() const
+{
+  return m_race_results.empty() ? 0 : m_race_results.front().iterations();
+}
+
+double profile_set_t::race_mean() const
+{
+  return m_race_results.empty() ? 0 : m_race_results.front().mean();
+}
+
+double profile_set_t::race_error() const
 {
+  auto n = race_iterations();
+  return n > 1 ? m_race_results.front().stddev() / std::sqrt( as<double>( n ) ) : 0;
 }
 
 sim_control_t* profile_set_t::options() const
@@ -291,6 +436,20 @@ void profile_set_t::cleanup_options()
 profile_set_t::~profile_set_t()
 {
   delete m_options;
+  delete m_sim;
+}
+
+void profile_set_t::prepared( sim_t* sim )
+{
+  assert( m_sim == nullptr );
+  m_sim = sim;
+}
+
+sim_t* profile_set_t::release_prepared()
+{
+  auto sim = m_sim;
+  m_sim = nullptr;
+  return sim;
 }
 
 const profile_result_t& profile_set_t::result( scale_metric_e metric ) const
@@ -337,27 +496,21 @@ profile_result_t& profile_set_t::result( scale_metric_e metric )
   return m_results.back();
 }
 
-worker_t::worker_t( profilesets_t* master, sim_t* p, profile_set_t* ps ) :
-  m_done( false ), m_parent( p ), m_master( master ), m_sim( nullptr ), m_profileset( ps ),
-  m_thread( nullptr )
+worker_t::worker_t( profilesets_t* master, sim_t* p, profile_set_t* ps, sim_t* prepared, int iterations ) :
+  m_done( false ), m_parent( p ), m_master( master ), m_sim( prepared ), m_profileset( ps ),
+  m_iterations( iterations )
 {
-  m_thread = new std::thread( std::bind( &worker_t::execute, this ) );
+  launch();
 }
 
 worker_t::~worker_t()
 {
   delete m_sim;
-  delete m_thread;
-}
-
-std::thread& worker_t::thread()
-{
-  return *m_thread;
 }
 
-const std::thread& worker_t::thread() const
+void worker_t::run()
 {
-  return *m_thread;
+  execute();
 }
 
 sim_t* worker_t::sim() const
@@ -367,9 +520,12 @@ sim_t* worker_t::sim() const
 
 void worker_t::execute()
 {
-  m_sim = new sim_t( m_parent, 0, m_profileset -> options() );
+  if ( m_sim == nullptr )
+  {
+    m_sim = new sim_t( m_parent, 0, m_profileset -> options() );
+  }
 
-  simulate_profileset( m_parent, *m_profileset, m_sim );
+  simulate_profileset( m_parent, *m_profileset, m_sim, m_iterations );
 
   m_done = true;
 
@@ -395,7 +551,7 @@ void profilesets_t::cleanup_work()
   {
     if ( ( *it ) -> is_done() )
     {
-      ( *it ) -> thread().join();
+      ( *it ) -> join();
 
       auto sim = ( *it ) -> sim();
 
@@ -440,19 +596,24 @@ void profilesets_t::finalize_work()
   }
 }
 
-void profilesets_t::generate_work( sim_t* parent, std::unique_ptr<profile_set_t>& ptr_set )
+void profilesets_t::generate_work( sim_t* parent, profile_set_t* set )
 {
   if ( m_mode == SEQUENTIAL )
   {
-    auto original_opts = parent -> control;
+    sim_t* profile_sim = take_prepared( set );
 
-    parent -> control = ptr_set -> options();
+    if ( profile_sim == nullptr )
+    {
+      auto original_opts = parent -> control;
 
-    sim_t* profile_sim = new sim_t( parent );
+      parent -> control = set -> options();
 
-    parent -> control = original_opts;
+      profile_sim = new sim_t( parent );
 
-    simulate_profileset( parent, *ptr_set.get(), profile_sim );
+      parent -> control = original_opts;
+    }
+
+    simulate_profileset( parent, *set, profile_sim, m_race_iterations );
 
     delete profile_sim;
   }
@@ -473,7 +634,8 @@ void profilesets_t::generate_work( sim_t* parent, std::unique_ptr<profile_set_t>
       // Output profileset progressbar whenever we finish anything
       output_progressbar( parent );
 
-      m_current_work.push_back( std::unique_ptr<worker_t>( new worker_t { this, parent, ptr_set.get() } ) );
+      m_current_work.push_back( std::unique_ptr<worker_t>(
+          new worker_t { this, parent, set, take_prepared( set ), m_race_iterations } ) );
     }
 
     m_work_lock.unlock();
@@ -540,13 +702,41 @@ bool profilesets_t::parse( sim_t* sim )
              util::str_compare_ci( name, "json2" );
     } ) != profileset_opts.end();
 
+    // With profileset_reuse_init, the initialized sim is kept for simulating the profileset. Limit
+    // the number of prepared sims waiting to be simulated, to bound memory use.
+    sim_t* prepared_sim = nullptr;
+    if ( sim -> profileset_reuse_init )
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_prepare.wait( lock, [ this, sim ]() {
+        return m_prepared < m_max_prepared || sim -> canceled || m_state == DONE;
+      } );
+
+      if ( sim -> canceled || m_state == DONE )
+      {
+        return false;
+      }
+
+      ++m_prepared;
+    }
+
     // Test that profileset options are OK, up to the simulation initialization
     try
     {
-      auto test_sim = new sim_t();
-      test_sim -> profileset_enabled = true;
+      sim_t* test_sim = nullptr;
+      if ( sim -> profileset_reuse_init )
+      {
+        test_sim = new sim_t( sim, 0, control );
+        setup_profileset_sim( test_sim );
+      }
+      else
+      {
+        test_sim = new sim_t();
+        test_sim -> profileset_enabled = true;
+
+        test_sim -> setup( control );
+      }
 
-      test_sim -> setup( control );
       auto ret = test_sim -> init();
       if ( ! ret || ! validate( test_sim ) )
       {
@@ -555,7 +745,14 @@ bool profilesets_t::parse( sim_t* sim )
         return false;
       }
 
-      delete test_sim;
+      if ( sim -> profileset_reuse_init )
+      {
+        prepared_sim = test_sim;
+      }
+      else
+      {
+        delete test_sim;
+      }
     }
     catch ( const std::exception& e )
     {
@@ -565,9 +762,14 @@ bool profilesets_t::parse( sim_t* sim )
       return false;
     }
 
+    auto set = new profile_set_t( profileset_name, control, has_output_opts );
+    if ( prepared_sim )
+    {
+      set -> prepared( prepared_sim );
+    }
+
     m_mutex.lock();
-    m_profilesets.push_back( std::unique_ptr<profile_set_t>(
-        new profile_set_t( profileset_name, control, has_output_opts ) ) );
+    m_profilesets.push_back( std::unique_ptr<profile_set_t>( set ) );
     m_control.notify_one();
     m_mutex.unlock();
   }
@@ -624,6 +826,9 @@ void profilesets_t::initialize( sim_t* sim )
 
   m_profilesets.reserve( sim -> profileset_map.size() + 1 );
 
+  // Keep enough prepared sims around to feed all workers, with some slack for the next ones
+  m_max_prepared = 2 * std::max( m_max_workers, as<size_t>( 1 ) );
+
   // Generate a copy of the original control, and remove any and all profileset. options from it
   m_original = std::unique_ptr<sim_control_t>( new sim_control_t() );
 
@@ -651,6 +856,12 @@ void profilesets_t::initialize( sim_t* sim )
 
 void profilesets_t::cancel()
 {
+  // Initialization threads may be waiting for room for prepared sims. Synchronize on the mutex so
+  // that a thread cannot miss the wakeup between checking the cancel state and waiting.
+  m_mutex.lock();
+  m_mutex.unlock();
+  m_prepare.notify_all();
+
   if ( ! is_done() )
   {
     range::for_each( m_thread, []( std::thread& thread ) {
@@ -671,6 +882,10 @@ void profilesets_t::set_state( state new_state )
   m_state = new_state;
 
   m_mutex.unlock();
+
+  // Wake up the profileset driver and initialization threads waiting on the state
+  m_control.notify_all();
+  m_prepare.notify_all();
 }
 
 std::string profilesets_t::current_profileset_name()
@@ -699,30 +914,18 @@ bool profilesets_t::iterate( sim_t* parent )
 
   m_start_time = util::wall_time();
 
-  while ( ! is_done() )
+  if ( parent -> profileset_race )
   {
-    m_control_lock.lock();
-
-    // Wait until we have at least something to sim
-    while ( is_initializing() && m_profilesets.size() - m_work_index == 0 )
-    {
-      m_control.wait( m_control_lock );
-    }
+    race( parent );
+  }
 
-    // Break out of iteration loop if all work has been done
-    if ( is_running() )
+  while ( auto set = next_profileset() )
+  {
+    if ( set -> eliminated() )
     {
-      if ( m_work_index == m_profilesets.size() )
-      {
-        m_control_lock.unlock();
-        break;
-      }
+      continue;
     }
 
-    auto& set = m_profilesets[ m_work_index++ ];
-
-    m_control_lock.unlock();
-
     generate_work( parent, set );
   }
 
@@ -740,6 +943,163 @@ bool profilesets_t::iterate( sim_t* parent )
   return true;
 }
 
+// Hand out the next profileset to simulate, waiting for the initialization threads if needed.
+// Returns nullptr once all profilesets have been handed out, or profileset processing is done.
+profile_set_t* profilesets_t::next_profileset()
+{
+  profile_set_t* set = nullptr;
+
+  m_control_lock.lock();
+
+  // Wait until we have at least something to sim
+  while ( is_initializing() && m_profilesets.size() - m_work_index == 0 )
+  {
+    m_control.wait( m_control_lock );
+  }
+
+  if ( ! is_done() && m_work_index < m_profilesets.size() )
+  {
+    set = m_profilesets[ m_work_index++ ].get();
+  }
+
+  m_control_lock.unlock();
+
+  return set;
+}
+
+// Take the prepared sim of a profileset, if any, and make room for the initialization threads to
+// prepare a new one
+sim_t* profilesets_t::take_prepared( profile_set_t* set )
+{
+  auto sim = set -> release_prepared();
+  if ( sim == nullptr )
+  {
+    return nullptr;
+  }
+
+  m_mutex.lock();
+  --m_prepared;
+  m_mutex.unlock();
+
+  m_prepare.notify_one();
+
+  return sim;
+}
+
+// Run screening rounds of doubling iteration counts over all profilesets, eliminating profilesets
+// that are statistically worse than the leader after each round. Rounds continue while the
+// screening iterations stay below half of the baseline iterations.
+void profilesets_t::race( sim_t* parent )
+{
+  auto baseline_iterations = parent -> progress( nullptr, 0 ).current_iterations;
+
+  m_race_rounds = 0;
+  for ( int iterations = parent -> profileset_race_iterations;
+        iterations > 0 && iterations * 2 <= baseline_iterations;
+        iterations *= 2 )
+  {
+    ++m_race_rounds;
+  }
+
+  for ( int iterations = parent -> profileset_race_iterations;
+        iterations > 0 && iterations * 2 <= baseline_iterations && ! is_done() && ! parent -> canceled;
+        iterations *= 2 )
+  {
+    m_control_lock.lock();
+    m_race_iterations = iterations;
+    m_work_index = 0;
+    m_control_lock.unlock();
+
+    // The first round also waits for the profilesets to be initialized, and racing compares all of
+    // them after it
+    while ( auto set = next_profileset() )
+    {
+      if ( ! set -> eliminated() )
+      {
+        generate_work( parent, set );
+      }
+    }
+
+    finalize_work();
+
+    eliminate( parent );
+
+    output_progressbar( parent );
+  }
+
+  m_control_lock.lock();
+  m_race_iterations = 0;
+  m_work_index = 0;
+  m_control_lock.unlock();
+}
+
+// Eliminate profilesets whose primary metric is worse than the current leader (best of the
+// baseline and the remaining profilesets) with the configured one-sided confidence. The confidence
+// is Bonferroni-corrected for the comparisons made in the round and for the maximum number of
+// rounds, so the error rate holds over the whole race. Eliminated profilesets keep their screening
+// samples as their results.
+void profilesets_t::eliminate( sim_t* parent )
+{
+  auto metric = parent -> profileset_metric.front();
+  double sign = lower_is_better( metric ) ? -1.0 : 1.0;
+
+  const auto baseline = parent -> player_no_pet_list.data().front();
+  auto baseline_data = metric_data( baseline, metric );
+  auto baseline_iterations = parent -> progress( nullptr, 0 ).current_iterations;
+
+  double leader_mean = baseline_data.mean;
+  double leader_error = baseline_iterations > 1
+                        ? baseline_data.std_dev / std::sqrt( baseline_iterations )
+                        : 0;
+
+  const profile_set_t* leader = nullptr;
+  size_t comparisons = 0;
+
+  range::for_each( m_profilesets, [ & ]( const profileset_entry_t& set ) {
+    if ( set -> eliminated() )
+    {
+      return;
+    }
+
+    ++comparisons;
+
+    if ( sign * set -> race_mean() > sign * leader_mean )
+    {
+      leader = set.get();
+      leader_mean = set -> race_mean();
+      leader_error = set -> race_error();
+    }
+  } );
+
+  // The leading profileset is not compared against itself
+  if ( leader != nullptr )
+  {
+    --comparisons;
+  }
+
+  double alpha = ( 1.0 - parent -> profileset_race_confidence ) /
+                 ( std::max( comparisons, as<size_t>( 1 ) ) * std::max( m_race_rounds, 1 ) );
+  double z = rng::stdnormal_inv( 1.0 - alpha );
+
+  range::for_each( m_profilesets, [ & ]( const profileset_entry_t& set ) {
+    if ( set -> eliminated() || set.get() == leader )
+    {
+      return;
+    }
+
+    double difference = sign * ( leader_mean - set -> race_mean() );
+    double error = std::sqrt( leader_error * leader_error + set -> race_error() * set -> race_error() );
+    if ( difference > z * error )
+    {
+      set -> eliminate();
+      set -> race_fold();
+      set -> cleanup_options();
+      delete take_prepared( set.get() );
+      ++m_eliminated;
+    }
+  } );
+}
+
 void profilesets_t::notify_worker()
 {
   m_work.notify_one();
@@ -775,6 +1135,16 @@ void profilesets_t::output_progressbar( const sim_t* parent ) const
 
   s << done << "/" << m_profilesets.size() << " ";
 
+  if ( m_race_iterations > 0 )
+  {
+    s << "race=" << m_race_iterations << " ";
+  }
+
+  if ( m_eliminated > 0 )
+  {
+    s << "eliminated=" << m_eliminated << " ";
+  }
+
   std::string status = "[";
   status.insert( 1, parent -> progress_bar.steps, '.' );
   status += "]";
@@ -847,6 +1217,11 @@ void profilesets_t::output( const sim_t& sim, js::JsonOutput& root ) const
 
     obj[ "iterations" ] = as<uint64_t>( result.iterations() );
 
+    if ( profileset -> eliminated() )
+    {
+      obj[ "eliminated" ] = true;
+    }
+
     if ( profileset -> results() > 1 )
     {
       auto results2 = obj[ "additional_metrics" ].make_array();
@@ -887,16 +1262,24 @@ void profilesets_t::output( const sim_t& sim, FILE* out ) const
     return;
   }
 
-  util::fprintf( out, "\n\nProfilesets (median %s):\n",
+  util::fprintf( out, "\n\nProfilesets (%s %s):\n", rank_name( sim ),
     util::scale_metric_type_string( sim.profileset_metric.front() ) );
 
   std::vector<const profile_set_t*> results;
-  generate_sorted_profilesets( results );
+  generate_sorted_profilesets( sim, results );
 
-  range::for_each( results, [ out ]( const profile_set_t* profileset ) {
-    util::fprintf( out, "    %-10.3f : %s\n",
-      profileset -> result().median(), profileset -> name().c_str() );
+  range::for_each( results, [ out, &sim ]( const profile_set_t* profileset ) {
+    util::fprintf( out, "    %-10.3f : %s%s\n",
+      rank_value( sim, profileset -> result().statistical_data() ), profileset -> name().c_str(),
+      profileset -> eliminated() ? " (eliminated)" : "" );
   } );
+
+  if ( m_eliminated > 0 )
+  {
+    util::fprintf( out, "\n  %u/%u profilesets eliminated by racing (confidence=%.3f)\n",
+      as<unsigned>( m_eliminated ), as<unsigned>( m_profilesets.size() ),
+      sim.profileset_race_confidence );
+  }
 }
 
 void profilesets_t::output( const sim_t& sim, io::ofstream& out ) const
@@ -916,15 +1299,16 @@ void profilesets_t::output( const sim_t& sim, io::ofstream& out ) const
   out << "</div>";
 }
 
-void profilesets_t::generate_sorted_profilesets( std::vector<const profile_set_t*>& out ) const
+void profilesets_t::generate_sorted_profilesets( const sim_t& sim, std::vector<const profile_set_t*>& out ) const
 {
   range::transform( m_profilesets, std::back_inserter( out ), []( const profileset_entry_t& p ) {
     return p.get();
   } );
 
-  // Sort to descending with mean value
-  range::sort( out, []( const profile_set_t* l, const profile_set_t* r ) {
-    return l -> result().median() > r -> result().median();
+  // Sort to descending with the ranked value
+  range::sort( out, [ &sim ]( const profile_set_t* l, const profile_set_t* r ) {
+    return rank_value( sim, l -> result().statistical_data() ) >
+           rank_value( sim, r -> result().statistical_data() );
   } );
 }
 
@@ -939,9 +1323,11 @@ bool profilesets_t::generate_chart( const sim_t& sim, io::ofstream& out ) const
   // Bar color
   const auto& c = color::class_color( sim.player_no_pet_list.data().front() -> type );
   std::string chart_name = util::scale_metric_type_string( sim.profileset_metric.front() );
+  std::string rank = rank_name( sim );
+  double baseline_value = rank_value( sim, baseline_data );
 
   std::vector<const profile_set_t*> results;
-  generate_sorted_profilesets( results );
+  generate_sorted_profilesets( sim, results );
 
   while ( chart_id * MAX_CHART_ENTRIES < m_profilesets.size() )
   {
@@ -956,10 +1342,10 @@ bool profilesets_t::generate_chart( const sim_t& sim, io::ofstream& out ) const
     profileset.set( "series.1.name", chart_name );
     profileset.set( "yAxis.gridLineWidth", 0 );
     profileset.set( "xAxis.offset", data_label_width );
-    profileset.set_title( "Profile sets (median " + chart_name + ")" );
+    profileset.set_title( "Profile sets (" + rank + " " + chart_name + ")" );
     profileset.set( "subtitle.text", "Baseline in red" );
     profileset.set( "subtitle.style.color", "#AA0000" );
-    profileset.set_yaxis_title( "Median " + chart_name );
+    profileset.set_yaxis_title( ( sim.profileset_race ? "Mean " : "Median " ) + chart_name );
     profileset.width_ = 1150;
     profileset.height_ = 24 * std::min( as<size_t>( MAX_CHART_ENTRIES + 1 ), results.size() - base_offset + 1 ) + 150;
 
@@ -1018,18 +1404,18 @@ bool profilesets_t::generate_chart( const sim_t& sim, io::ofstream& out ) const
       const auto set = results[ i ];
       const auto& data = set -> result( sim.profileset_metric.front() );
 
-      if ( ! inserted && data.median() <= baseline_data.median )
+      if ( ! inserted && rank_value( sim, data.statistical_data() ) <= baseline_value )
       {
-        insert_data( profileset, sim.player_no_pet_list.data().front() -> name(), c, baseline_data, true, baseline_data.median );
+        insert_data( profileset, sim, sim.player_no_pet_list.data().front() -> name(), c, baseline_data, true, baseline_value );
         inserted = true;
       }
 
-      insert_data( profileset, set -> name(), c, set -> result().statistical_data(), false, baseline_data.median );
+      insert_data( profileset, sim, set -> name(), c, set -> result().statistical_data(), false, baseline_value );
     }
 
     if ( inserted == false )
     {
-      insert_data( profileset, sim.player_no_pet_list.data().front() -> name(), c, baseline_data, true, baseline_data.median );
+      insert_data( profileset, sim, sim.player_no_pet_list.data().front() -> name(), c, baseline_data, true, baseline_value );
     }
 
     out << profileset.to_string();
@@ -1079,6 +1465,10 @@ void create_options( sim_t* sim )
 
   sim -> add_option( opt_int( "profileset_work_threads", sim -> profileset_work_threads ) );
   sim -> add_option( opt_int( "profileset_init_threads", sim -> profileset_init_threads ) );
+  sim -> add_option( opt_bool( "profileset_race", sim -> profileset_race ) );
+  sim -> add_option( opt_float( "profileset_race_confidence", sim -> profileset_race_confidence, 0.5, 0.9999 ) );
+  sim -> add_option( opt_int( "profileset_race_iterations", sim -> profileset_race_iterations ) );
+  sim -> add_option( opt_bool( "profileset_reuse_init", sim -> profileset_reuse_init ) );
 }
 
 statistical_data_t collect( const extended_sample_data_t& c )
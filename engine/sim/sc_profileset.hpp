@@ -13,6 +13,7 @@
 
 #include "sc_option.hpp"
 #include "util/generic.hpp"
+#include "util/concurrency.hpp"
 #include "util/io.hpp"
 #include "sc_enums.hpp"
 
@@ -364,6 +365,13 @@ class profile_set_t
   std::vector<profile_result_t>          m_results;
   std::unique_ptr<profile_output_data_t> m_output_data;
 
+  // Racing state, results accumulated over the screening rounds (primary metric first)
+  bool                                   m_eliminated;
+  std::vector<profile_result_t>          m_race_results;
+
+  // Initialized sim prepared by the profileset initialization, owned until released
+  sim_t*                                 m_sim;
+
 public:
   profile_set_t( const std::string& name, sim_control_t* opts, bool has_output );
 
@@ -376,6 +384,11 @@ public:
 
   sim_control_t* options() const;
 
+  void prepared( sim_t* sim );
+
+  // Release ownership of the prepared sim to the caller, nullptr if there is none
+  sim_t* release_prepared();
+
   bool has_output() const
   { return m_has_output; }
 
@@ -386,6 +399,25 @@ public:
   size_t results() const
   { return m_results.size(); }
 
+  bool eliminated() const
+  { return m_eliminated; }
+
+  void eliminate()
+  { m_eliminated = true; }
+
+  // Accumulate a screening round result of a metric
+  void race_add( const profile_result_t& result );
+
+  // Fold the accumulated screening samples into the results of the full run, or into the empty
+  // results of an eliminated profileset
+  void race_fold();
+
+  size_t race_iterations() const;
+
+  // Accumulated racing mean of the primary metric, and its standard error
+  double race_mean() const;
+  double race_error() const;
+
   profile_output_data_t& output_data()
   {
     if ( ! m_output_data )
@@ -397,7 +429,7 @@ public:
   }
 };
 
-class worker_t
+class worker_t : private sc_thread_t
 {
   bool           m_done;
   sim_t*         m_parent;
@@ -405,14 +437,14 @@ class worker_t
 
   sim_t*         m_sim;
   profile_set_t* m_profileset;
-  std::thread*   m_thread;
+  int            m_iterations;
 
+  void run() override;
 public:
-  worker_t( profilesets_t*, sim_t*, profile_set_t* );
+  worker_t( profilesets_t*, sim_t*, profile_set_t*, sim_t* prepared = nullptr, int iterations = 0 );
   ~worker_t();
 
-  const std::thread& thread() const;
-  std::thread& thread();
+  using sc_thread_t::join;
   void execute();
 
   bool is_done() const
@@ -469,29 +501,47 @@ class profilesets_t
   double                                 m_start_time;
   double                                 m_total_elapsed;
 
+  // Prepared (initialized) profileset sims waiting to be simulated, and the maximum number of them
+  // the initialization threads may keep in memory
+  size_t                                 m_prepared;
+  size_t                                 m_max_prepared;
+  std::condition_variable                m_prepare;
+
+  // Profileset racing, iterations of the current screening round (0 for the full run), and the
+  // maximum number of screening rounds
+  int                                    m_race_iterations;
+  int                                    m_race_rounds;
+  size_t                                 m_eliminated;
+
   bool validate( sim_t* sim );
 
   int max_name_length() const;
 
   bool generate_chart( const sim_t& sim, io::ofstream& out ) const;
-  void generate_sorted_profilesets( std::vector<const profile_set_t*>& out ) const;
+  void generate_sorted_profilesets( const sim_t& sim, std::vector<const profile_set_t*>& out ) const;
 
   void output_progressbar( const sim_t* ) const;
 
   void set_state( state new_state );
 
   size_t n_workers() const;
-  void generate_work( sim_t*, std::unique_ptr<profile_set_t>& );
+  profile_set_t* next_profileset();
+  sim_t* take_prepared( profile_set_t* );
+  void generate_work( sim_t*, profile_set_t* );
   void cleanup_work();
   void finalize_work();
 
+  void race( sim_t* );
+  void eliminate( sim_t* );
+
   sim_control_t* create_sim_options( const sim_control_t*, const std::vector<std::string>& opts );
 public:
   profilesets_t() : m_state( STARTED ), m_mode( SEQUENTIAL ),
     m_original( nullptr ), m_insert_index( -1 ),
     m_work_index( 0 ), m_control_lock( m_mutex, std::defer_lock ),
     m_max_workers( 0 ), m_work_lock( m_work_mutex, std::defer_lock ),
-    m_start_time( 0 ), m_total_elapsed( 0 )
+    m_start_time( 0 ), m_total_elapsed( 0 ), m_prepared( 0 ), m_max_prepared( 0 ),
+    m_race_iterations( 0 ), m_race_rounds( 0 ), m_eliminated( 0 )
   { }
 
   ~profilesets_t()
@@ -503,7 +553,7 @@ public:
       }
     } );
 
-    range::for_each( m_current_work, []( std::unique_ptr<worker_t>& worker ) { worker -> thread().join(); } );
+    range::for_each( m_current_work, []( std::unique_ptr<worker_t>& worker ) { worker -> join(); } );
   }
 
   size_t n_profilesets() const
@@ -511,6 +561,9 @@ public:
 
   size_t done_profilesets() const;
 
+  size_t eliminated_profilesets() const
+  { return m_eliminated; }
+
   // Worker sim finished
   void notify_worker();
 
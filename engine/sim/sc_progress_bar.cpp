@@ -134,6 +134,24 @@ bool progress_bar_t::update( bool finished, int index )
   }
 }
 
+// Update the status from externally aggregated progress, e.g. several child sims running at once
+bool progress_bar_t::update( const sim_progress_t& progress, bool finished )
+{
+  if ( ! sim.report_progress )
+  {
+    return false;
+  }
+
+  if ( sim.progressbar_type == 1 )
+  {
+    return update_simple( progress, finished, -1 );
+  }
+  else
+  {
+    return update_normal( progress, finished, -1 );
+  }
+}
+
 bool progress_bar_t::update_simple( const sim_progress_t& progress, bool finished, int /* index */ )
 {
   auto pct = progress.pct();
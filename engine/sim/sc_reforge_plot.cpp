@@ -47,14 +47,15 @@ bool is_plot_stat( sim_t* sim, stat_e stat )
 
 reforge_plot_t::reforge_plot_t( sim_t* s )
   : sim( s ),
-    current_reforge_sim( nullptr ),
     reforge_plot_step( 20 ),
     reforge_plot_amount( 200 ),
     reforge_plot_iterations( -1 ),
     reforge_plot_target_error( 0 ),
     reforge_plot_debug( 0 ),
     current_stat_combo( -1 ),
-    num_stat_combos( 0 )
+    num_stat_combos( 0 ),
+    reforge_plot_concurrent( 0 ),
+    batch( s )
 {
   create_options();
 }
@@ -162,62 +163,73 @@ void reforge_plot_t::analyze_stats()
     }
   }
 
-  for ( size_t i = 0; i < stat_mods.size(); i++ )
-  {
-    if ( sim->is_canceled() )
-      break;
+  // Plot data of each stat combination, per player (by name)
+  std::vector<std::vector<std::vector<plot_data_t>>> results( stat_mods.size() );
 
-    std::vector<plot_data_t> delta_result( stat_mods[ i ].size() + 1 );
+  sim->progress_bar.set_base( "Reforge" );
+  sim->progress_bar.set_phase( "All" );
 
-    current_reforge_sim = new sim_t( sim );
-    if ( reforge_plot_iterations > 0 )
-    {
-      current_reforge_sim->work_queue->init( reforge_plot_iterations );
-    }
+  // Marks the reforge plot as running for the signal handler and the progress of the child sims.
+  // Only written here, before any child sim starts and after all of them have finished.
+  current_stat_combo = 0;
 
-    std::stringstream s;
-    for ( size_t j = 0; j < stat_mods[ i ].size(); j++ )
-    {
-      stat_e stat = reforge_plot_stat_indices[ j ];
-      int mod     = stat_mods[ i ][ j ];
-
-      current_reforge_sim -> enchant.add_stat( stat, mod );
-      delta_result[ j ].value = mod;
-      delta_result[ j ].error = 0;
+  batch.execute( stat_mods.size(), reforge_plot_concurrent ? 0 : 1,
+    [ this, &stat_mods ]( size_t i, sim_control_t* control ) {
+      sim_t* reforge_sim = new sim_t( sim, 0, control );
+      if ( reforge_plot_iterations > 0 )
+      {
+        reforge_sim->work_queue->init( reforge_plot_iterations );
+      }
 
-      s << util::to_string( mod ) << " " << util::stat_type_abbrev( stat );
-      if ( j < stat_mods[ i ].size() - 1 )
+      std::stringstream s;
+      for ( size_t j = 0; j < stat_mods[ i ].size(); j++ )
       {
-        s << ", ";
+        stat_e stat = reforge_plot_stat_indices[ j ];
+        int mod     = stat_mods[ i ][ j ];
+
+        reforge_sim -> enchant.add_stat( stat, mod );
+
+        s << util::to_string( mod ) << " " << util::stat_type_abbrev( stat );
+        if ( j < stat_mods[ i ].size() - 1 )
+        {
+          s << ", ";
+        }
       }
-    }
 
-    current_stat_combo = as<int>( i );
-    current_reforge_sim -> progress_bar.set_base( s.str() );
-    current_reforge_sim -> execute();
+      reforge_sim -> progress_bar.set_base( s.str() );
+      return reforge_sim;
+    },
+    [ this, &stat_mods, &results ]( size_t i, std::unique_ptr<sim_t>& reforge_sim ) {
+      std::vector<plot_data_t> delta_result( stat_mods[ i ].size() + 1 );
+      for ( size_t j = 0; j < stat_mods[ i ].size(); j++ )
+      {
+        delta_result[ j ].value = stat_mods[ i ][ j ];
+        delta_result[ j ].error = 0;
+      }
 
-    for ( player_t* player : sim->players_by_name )
-    {
-      if ( current_reforge_sim )
+      for ( player_t* player : sim->players_by_name )
       {
         plot_data_t& data = delta_result[ stat_mods[ i ].size() ];
-        player_t* delta_p = current_reforge_sim->find_player( player->name() );
+        player_t* delta_p = reforge_sim->find_player( player->name() );
 
         scaling_metric_data_t scaling_data =
             delta_p->scaling_for_metric( player->sim->scaling->scaling_metric );
 
         data.value = scaling_data.value;
         data.error =
-            scaling_data.stddev * current_reforge_sim->confidence_estimator;
+            scaling_data.stddev * reforge_sim->confidence_estimator;
 
-        player->reforge_plot_data.push_back( delta_result );
+        results[ i ].push_back( delta_result );
       }
-    }
+    } );
 
-    if ( current_reforge_sim )
+  current_stat_combo = -1;
+
+  for ( const auto& result : results )
+  {
+    for ( size_t k = 0; k < result.size(); k++ )
     {
-      delete current_reforge_sim;
-      current_reforge_sim = nullptr;
+      sim->players_by_name[ k ]->reforge_plot_data.push_back( result[ k ] );
     }
   }
 }
@@ -287,8 +299,9 @@ double reforge_plot_t::progress( std::string& phase, std::string* detailed )
   if ( num_stat_combos <= 0 )
     return 1.0;
 
-  if ( current_stat_combo <= 0 )
-    return 0.0;
+  // Not running, or already finished
+  if ( current_stat_combo < 0 )
+    return 1.0;
 
   phase = "Reforge - ";
   for ( size_t i = 0; i < reforge_plot_stat_indices.size(); i++ )
@@ -298,32 +311,13 @@ double reforge_plot_t::progress( std::string& phase, std::string* detailed )
       phase += " to ";
   }
 
-  int total_iter =
-      num_stat_combos * ( reforge_plot_iterations > 0 ? reforge_plot_iterations
-                                                      : sim->iterations );
-  int reforge_iter = current_stat_combo * ( reforge_plot_iterations > 0
-                                                ? reforge_plot_iterations
-                                                : sim->iterations );
-
-  if ( current_reforge_sim && current_reforge_sim->current_iteration > 0 )
-  {
-    // Add current reforge iterations only if the update does not land on a
-    // partition
-    // operation
-    if ( (int)current_reforge_sim->children.size() ==
-         current_reforge_sim->threads - 1 )
-      reforge_iter += current_reforge_sim->current_iteration * sim->threads;
-    // At partition, add an extra amount of iterations to keep the iterations
-    // correct
-    else
-      reforge_iter += ( reforge_plot_iterations > 0 ? reforge_plot_iterations
-                                                    : sim->iterations );
-  }
-
-  sim->detailed_progress( detailed, (int)reforge_iter, (int)total_iter );
+  if ( ! batch.active() )
+    return 0.0;
 
-  return static_cast<double>( reforge_iter ) /
-         static_cast<double>( total_iter );
+  auto batch_progress = batch.progress();
+  sim->detailed_progress( detailed, batch_progress.current_iterations,
+                          batch_progress.total_iterations );
+  return batch_progress.pct();
 }
 
 // reforge_plot_t::create_options ===========================================
@@ -338,4 +332,5 @@ void reforge_plot_t::create_options()
   sim->add_option( opt_int( "reforge_plot_amount", reforge_plot_amount ) );
   sim->add_option( opt_string( "reforge_plot_stat", reforge_plot_stat_str ) );
   sim->add_option( opt_bool( "reforge_plot_debug", reforge_plot_debug ) );
+  sim->add_option( opt_bool( "reforge_plot_concurrent", reforge_plot_concurrent ) );
 }
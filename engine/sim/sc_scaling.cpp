@@ -90,6 +90,51 @@ struct compare_scale_factors
   }
 };
 
+// crn_paired_stddev ========================================================
+
+// Standard deviation of the mean of ( delta - ref ) scale metric differences over the iterations
+// both sims ran with the same random numbers, estimated from the spread of the per-batch mean
+// differences. Negative if the batches of the two sims did not cover the same iterations, or fewer
+// than two batches have data.
+double crn_paired_stddev( const player_t& ref, const player_t& delta )
+{
+  const auto& r = ref.collected_data.crn_scaling_metric;
+  const auto& d = delta.collected_data.crn_scaling_metric;
+
+  double total = 0;
+  uint64_t n = 0;
+  unsigned batches = 0;
+  for ( unsigned i = 0; i < crn_batch_means_t::N_BATCHES; ++i )
+  {
+    if ( r.count[ i ] != d.count[ i ] || r.index_sum[ i ] != d.index_sum[ i ] )
+      return -1;
+
+    if ( r.count[ i ] == 0 )
+      continue;
+
+    total += d.sum[ i ] - r.sum[ i ];
+    n += r.count[ i ];
+    ++batches;
+  }
+
+  if ( batches < 2 )
+    return -1;
+
+  double mean = total / n;
+  double m2 = 0;
+  for ( unsigned i = 0; i < crn_batch_means_t::N_BATCHES; ++i )
+  {
+    if ( r.count[ i ] == 0 )
+      continue;
+
+    double x = ( d.sum[ i ] - r.sum[ i ] ) / r.count[ i ] - mean;
+    m2 += r.count[ i ] * x * x;
+  }
+
+  // Per-iteration variance of the differences, from the weighted variance of the batch means
+  return std::sqrt( m2 / ( batches - 1 ) / n );
+}
+
 } // UNNAMED NAMESPACE ====================================================
 
 // ==========================================================================
@@ -111,10 +156,12 @@ scaling_t::scaling_t( sim_t* s ) :
   scale_factor_noise( 0.10 ),
   normalize_scale_factors( 0 ),
   debug_scale_factors( 0 ),
+  concurrent_scale_factors( 0 ),
   current_scaling_stat( STAT_NONE ),
   num_scaling_stats( 0 ),
   remaining_scaling_stats( 0 ),
-  scale_over(), scaling_metric( SCALE_METRIC_DPS ), scale_over_player()
+  scale_over(), scaling_metric( SCALE_METRIC_DPS ), scale_over_player(),
+  batch( s )
 {
   create_options();
 }
@@ -136,6 +183,13 @@ double scaling_t::progress( std::string& phase, std::string* detailed )
     return baseline_sim -> progress(detailed ).pct();
   }
 
+  if ( batch.active() )
+  {
+    phase = "Scaling - All";
+    sim -> detailed_progress( detailed, as<int>( batch.completed() ), as<int>( batch.size() ) );
+    return batch.progress().pct();
+  }
+
   phase  = "Scaling - ";
   phase += util::stat_type_abbrev( current_scaling_stat );
 
@@ -217,122 +271,221 @@ void scaling_t::analyze_stats()
   baseline_sim = sim; // Take the current sim as baseline
   mutex.unlock();
 
-  for ( size_t k = 0; k < stats_to_scale.size(); ++k )
+  if ( concurrent_scale_factors )
+  {
+    analyze_stats_concurrent( stats_to_scale );
+  }
+  else
   {
-    if ( sim -> is_canceled() ) break;
+    for ( size_t k = 0; k < stats_to_scale.size(); ++k )
+    {
+      if ( sim -> is_canceled() ) break;
 
-    current_scaling_stat = stats_to_scale[ k ]; // Stat we're scaling over
-    const stat_e& stat = current_scaling_stat;
+      current_scaling_stat = stats_to_scale[ k ]; // Stat we're scaling over
+      const stat_e& stat = current_scaling_stat;
 
-    double scale_delta = stats.get_stat( stat );
-    assert ( scale_delta );
+      double scale_delta = stats.get_stat( stat );
+      assert ( scale_delta );
 
-    bool center = center_scale_delta && ! stat_may_cap( stat );
+      bool center = center_scale_delta && ! stat_may_cap( stat );
 
-    mutex.lock();
-    ref_sim = baseline_sim;
-    delta_sim = new sim_t( sim );
-    mutex.unlock();
+      mutex.lock();
+      ref_sim = baseline_sim;
+      delta_sim = new sim_t( sim );
+      mutex.unlock();
 
-    delta_sim -> progress_bar.set_base( util::stat_type_abbrev( stat ) );
+      delta_sim -> progress_bar.set_base( util::stat_type_abbrev( stat ) );
 
-    delta_sim -> scaling -> scale_stat = stat;
-    delta_sim -> scaling -> scale_value = +scale_delta / ( center ? 2 : 1 );
-    delta_sim -> execute();
+      delta_sim -> scaling -> scale_stat = stat;
+      delta_sim -> scaling -> scale_value = +scale_delta / ( center ? 2 : 1 );
+      delta_sim -> execute();
+
+      if ( center )
+      {
+        mutex.lock();
+        ref_sim = new sim_t( sim );
+        mutex.unlock();
+
+        ref_sim -> progress_bar.set_base( std::string( "Ref " ) + util::stat_type_abbrev( stat ) );
+
+        ref_sim -> scaling -> scale_stat = stat;
+        ref_sim -> scaling -> scale_value = center ? -( scale_delta / 2 ) : 0;
+        ref_sim -> execute();
+      }
+
+      analyze_stat( stat, scale_delta, center, ref_sim, delta_sim );
 
-    if ( center )
-    {
       mutex.lock();
-      ref_sim = new sim_t( sim );
+      if ( ref_sim != baseline_sim && ref_sim != sim )
+      {
+        delete ref_sim;
+        ref_sim = nullptr;
+      }
+      delete delta_sim;  
+      delta_sim  = nullptr;
+      remaining_scaling_stats--;
       mutex.unlock();
+    }
+  }
+
+  if ( baseline_sim != sim ) delete baseline_sim;
+  baseline_sim = nullptr;
+}
 
-      ref_sim -> progress_bar.set_base( std::string( "Ref " ) + util::stat_type_abbrev( stat ) );
+// scaling_t::analyze_stats_concurrent ======================================
 
-      ref_sim -> scaling -> scale_stat = stat;
-      ref_sim -> scaling -> scale_value = center ? -( scale_delta / 2 ) : 0;
-      ref_sim -> execute();
-    }
+// Run the delta (and centered reference) sims of all stats at once instead of stat by stat. The
+// thread budget of the baseline sim is split between the concurrently running sims.
 
-    for ( size_t j = 0; j < sim -> players_by_name.size(); j++ )
+void scaling_t::analyze_stats_concurrent( const std::vector<stat_e>& stats_to_scale )
+{
+  struct job_t
+  {
+    stat_e stat;
+    double value;
+    std::string name;
+  };
+
+  std::vector<job_t> jobs;
+  // Indices to jobs for the delta and reference sim of each stat, npos when the baseline is the reference
+  std::vector<size_t> delta_job, ref_job;
+
+  for ( auto stat : stats_to_scale )
+  {
+    double scale_delta = stats.get_stat( stat );
+    assert( scale_delta );
+
+    bool center = center_scale_delta && ! stat_may_cap( stat );
+
+    delta_job.push_back( jobs.size() );
+    jobs.push_back( job_t { stat, +scale_delta / ( center ? 2 : 1 ), util::stat_type_abbrev( stat ) } );
+
+    if ( center )
+    {
+      ref_job.push_back( jobs.size() );
+      jobs.push_back( job_t { stat, -( scale_delta / 2 ), std::string( "Ref " ) + util::stat_type_abbrev( stat ) } );
+    }
+    else
     {
-      player_t* p = sim -> players_by_name[ j ];
+      ref_job.push_back( std::string::npos );
+    }
+  }
 
-      if ( ! p -> scaling -> scales_with[ stat ] ) continue;
+  mutex.lock();
+  current_scaling_stat = stats_to_scale.front();
+  mutex.unlock();
 
-      player_t*   ref_p =   ref_sim -> find_player( p -> name() );
-      player_t* delta_p = delta_sim -> find_player( p -> name() );
-      assert( ref_p && "Reference Player not found" );
-      assert( delta_p && "Delta player not found" );
+  sim -> progress_bar.set_base( "Scaling" );
+  sim -> progress_bar.set_phase( "All" );
+
+  std::vector<std::unique_ptr<sim_t>> job_sims( jobs.size() );
+  batch.execute( jobs.size(), 0,
+    [ this, &jobs ]( size_t job, sim_control_t* control ) {
+      sim_t* job_sim = new sim_t( sim, 0, control );
+      job_sim -> progress_bar.set_base( jobs[ job ].name );
+      job_sim -> scaling -> scale_stat = jobs[ job ].stat;
+      job_sim -> scaling -> scale_value = jobs[ job ].value;
+      return job_sim;
+    },
+    [ &job_sims ]( size_t job, std::unique_ptr<sim_t>& job_sim ) {
+      job_sims[ job ] = std::move( job_sim );
+    } );
+
+  for ( size_t k = 0; k < stats_to_scale.size() && ! sim -> is_canceled(); ++k )
+  {
+    sim_t* delta = job_sims[ delta_job[ k ] ].get();
+    sim_t* ref = ref_job[ k ] != std::string::npos ? job_sims[ ref_job[ k ] ].get() : baseline_sim;
+    if ( ! delta || ! ref ) continue;
 
-      double divisor = scale_delta;
+    analyze_stat( stats_to_scale[ k ], stats.get_stat( stats_to_scale[ k ] ),
+                  ref_job[ k ] != std::string::npos, ref, delta );
+  }
 
-      if ( delta_p -> invert_scaling )
-        divisor = -divisor;
+  mutex.lock();
+  remaining_scaling_stats = 0;
+  mutex.unlock();
+}
 
-      if ( divisor < 0.0 ) divisor += ref_p -> scaling -> over_cap[ stat ];
+// scaling_t::analyze_stat ==================================================
 
-      for ( scale_metric_e sm = SCALE_METRIC_NONE; sm < SCALE_METRIC_MAX; sm++ )
-      {
+// Compute the scale factors of a single stat from its finished reference and delta sims
 
-        double delta_score = delta_p -> scaling_for_metric( sm ).value;
-        double   ref_score = ref_p -> scaling_for_metric( sm ).value;
+void scaling_t::analyze_stat( stat_e stat, double scale_delta, bool center, sim_t* ref_sim, sim_t* delta_sim )
+{
+  for ( size_t j = 0; j < sim -> players_by_name.size(); j++ )
+  {
+    player_t* p = sim -> players_by_name[ j ];
 
-        double delta_error = delta_p -> scaling_for_metric( sm ).stddev * delta_sim -> confidence_estimator;
-        double   ref_error = ref_p -> scaling_for_metric( sm ).stddev * ref_sim -> confidence_estimator;
+    if ( ! p -> scaling -> scales_with[ stat ] ) continue;
 
-        // TODO: this is the only place in the entire code base where scaling_delta_dps shows up, 
-        // apart from declaration in simulationcraft.hpp line 4535. Possible to remove?
-        p -> scaling -> scaling_delta_dps[ sm ].set_stat( stat, delta_score );
+    player_t*   ref_p =   ref_sim -> find_player( p -> name() );
+    player_t* delta_p = delta_sim -> find_player( p -> name() );
+    assert( ref_p && "Reference Player not found" );
+    assert( delta_p && "Delta player not found" );
 
-        double score = ( delta_score - ref_score ) / divisor;
-        double error = delta_error * delta_error + ref_error * ref_error;
+    double divisor = scale_delta;
 
-        if ( error > 0 )
-          error = sqrt( error );
+    if ( delta_p -> invert_scaling )
+      divisor = -divisor;
 
-        error = fabs( error / divisor );
+    if ( divisor < 0.0 ) divisor += ref_p -> scaling -> over_cap[ stat ];
 
-        if ( fabs( divisor ) < 1.0 ) // For things like Weapon Speed, show the gain per 0.1 speed gain rather than every 1.0.
-        {
-          score /= 10.0;
-          error /= 10.0;
-          delta_error /= 10.0;
-        }
+    for ( scale_metric_e sm = SCALE_METRIC_NONE; sm < SCALE_METRIC_MAX; sm++ )
+    {
+
+      double delta_score = delta_p -> scaling_for_metric( sm ).value;
+      double   ref_score = ref_p -> scaling_for_metric( sm ).value;
+
+      double delta_error = delta_p -> scaling_for_metric( sm ).stddev * delta_sim -> confidence_estimator;
+      double   ref_error = ref_p -> scaling_for_metric( sm ).stddev * ref_sim -> confidence_estimator;
+
+      // TODO: this is the only place in the entire code base where scaling_delta_dps shows up, 
+      // apart from declaration in simulationcraft.hpp line 4535. Possible to remove?
+      p -> scaling -> scaling_delta_dps[ sm ].set_stat( stat, delta_score );
 
-        analyze_ability_stats( stat, divisor, p, ref_p, delta_p );
+      double score = ( delta_score - ref_score ) / divisor;
+      double error = delta_error * delta_error + ref_error * ref_error;
 
-        if ( center )
-          p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, error );
-        else
-          p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, delta_error / divisor );
+      if ( error > 0 )
+        error = sqrt( error );
 
-        p -> scaling -> scaling[ sm ].set_stat( stat, score );
-        p -> scaling -> scaling_error[ sm ].set_stat( stat, error );
+      // With common random numbers the runs are correlated, use the error of the paired
+      // per-iteration differences instead
+      if ( sim -> common_random_numbers && sm == scaling_metric )
+      {
+        double paired = crn_paired_stddev( *ref_p, *delta_p );
+        if ( paired >= 0 )
+          error = paired * delta_sim -> confidence_estimator;
       }
-    }
 
-    if ( debug_scale_factors )
-    {
-      std::cout << "\nref_sim report for '" << util::stat_type_string( stat ) << "'..." << std::endl;
-      report::print_text( ref_sim, true );
-      std::cout << "\ndelta_sim report for '" << util::stat_type_string( stat ) << "'..." << std::endl;
-      report::print_text( delta_sim, true );
-    }
+      error = fabs( error / divisor );
 
-    mutex.lock();
-    if ( ref_sim != baseline_sim && ref_sim != sim )
-    {
-      delete ref_sim;
-      ref_sim = nullptr;
+      if ( fabs( divisor ) < 1.0 ) // For things like Weapon Speed, show the gain per 0.1 speed gain rather than every 1.0.
+      {
+        score /= 10.0;
+        error /= 10.0;
+        delta_error /= 10.0;
+      }
+
+      analyze_ability_stats( stat, divisor, p, ref_p, delta_p );
+
+      if ( center )
+        p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, error );
+      else
+        p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, delta_error / divisor );
+
+      p -> scaling -> scaling[ sm ].set_stat( stat, score );
+      p -> scaling -> scaling_error[ sm ].set_stat( stat, error );
     }
-    delete delta_sim;  
-    delta_sim  = nullptr;
-    remaining_scaling_stats--;
-    mutex.unlock();
   }
 
-  if ( baseline_sim != sim ) delete baseline_sim;
-  baseline_sim = nullptr;
+  if ( debug_scale_factors )
+  {
+    std::cout << "\nref_sim report for '" << util::stat_type_string( stat ) << "'..." << std::endl;
+    report::print_text( ref_sim, true );
+    std::cout << "\ndelta_sim report for '" << util::stat_type_string( stat ) << "'..." << std::endl;
+    report::print_text( delta_sim, true );
+  }
 }
 
 /* Creates scale factors for stats_t objects
@@ -500,6 +653,7 @@ void scaling_t::create_options()
   sim->add_option(opt_func("normalize_scale_factors", parse_normalize_scale_factors));
   sim->add_option(opt_bool("debug_scale_factors", debug_scale_factors));
   sim->add_option(opt_bool("center_scale_delta", center_scale_delta));
+  sim->add_option(opt_bool("concurrent_scale_factors", concurrent_scale_factors));
   sim->add_option(opt_float("scale_delta_multiplier", scale_delta_multiplier)); // multiplies all default scale deltas
   sim->add_option(opt_bool("positive_scale_delta", positive_scale_delta));
   sim->add_option(opt_bool("scale_lag", scale_lag));
@@ -1324,6 +1324,17 @@ struct compare_name
   }
 };
 
+// crn_mix ==================================================================
+
+// SplitMix64 finalizer, used to derive common random numbers stream seeds
+uint64_t crn_mix( uint64_t x )
+{
+  x += 0x9E3779B97F4A7C15ULL;
+  x = ( x ^ ( x >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+  x = ( x ^ ( x >> 27 ) ) * 0x94D049BB133111EBULL;
+  return x ^ ( x >> 31 );
+}
+
 } // UNNAMED NAMESPACE ===================================================
 
 // ==========================================================================
@@ -1378,7 +1389,8 @@ sim_t::sim_t() :
   travel_variance( 0 ), default_skill( 1.0 ), reaction_time( timespan_t::from_seconds( 0.5 ) ),
   regen_periodicity( timespan_t::from_seconds( 0.25 ) ),
   ignite_sampling_delta( timespan_t::from_seconds( 0.2 ) ),
-  fixed_time( false ), optimize_expressions( false ),
+  fixed_time( false ), optimize_expressions( false ), compile_expressions( false ),
+  cache_action_readiness( false ),
   current_slot( -1 ),
   optimal_raid( 0 ), log( 0 ), debug_each( 0 ), save_profiles( 0 ), default_actions( 0 ),
   normalized_stat( STAT_NONE ),
@@ -1386,7 +1398,7 @@ sim_t::sim_t() :
   save_prefix_str( "save_" ),
   save_talent_str( 0 ),
   talent_format( TALENT_FORMAT_UNCHANGED ),
-  auto_ready_trigger( 0 ), stat_cache( 1 ), max_aoe_enemies( 20 ), show_etmi( 0 ), tmi_window_global( 0 ), tmi_bin_size( 0.5 ),
+  auto_ready_trigger( 0 ), stat_cache( 1 ), stat_cache_counters( false ), max_aoe_enemies( 20 ), aoe_snapshot_once( false ), show_etmi( 0 ), tmi_window_global( 0 ), tmi_bin_size( 0.5 ),
   requires_regen_event( false ), single_actor_batch( false ),
   progressbar_type( 0 ),
   armory_retries( 3 ),
@@ -1397,7 +1409,9 @@ sim_t::sim_t() :
   disable_set_bonuses( false ), disable_2_set( 1 ), disable_4_set( 1 ), enable_2_set( 1 ), enable_4_set( 1 ),
   pvp_crit( false ),
   active_enemies( 0 ), active_allies( 0 ),
-  _rng(), seed( 0 ), deterministic( 0 ), strict_work_queue( 0 ),
+  _rng(), rng_buffer( 0 ), seed( 0 ), deterministic( 0 ),
+  common_random_numbers( false ), crn_seed( 0 ), crn_iteration( 0 ), crn_iteration_offset( 0 ), crn_epoch( 0 ),
+  strict_work_queue( 0 ),
   average_range( true ), average_gauss( false ),
   convergence_scale( 2 ),
   fight_style( "Patchwerk" ), add_waves( 0 ), overrides( overrides_t() ),
@@ -1420,8 +1434,9 @@ sim_t::sim_t() :
   // Report
   report_precision(2), report_pets_separately( 0 ), report_targets( 1 ), report_details( 1 ), report_raw_abilities( 1 ),
   report_rng( 0 ), hosted_html( 0 ),
-  save_raid_summary( 0 ), save_gear_comments( 0 ), statistics_level( 1 ), separate_stats_by_actions( 0 ), report_raid_summary( 0 ), buff_uptime_timeline( 0 ),
+  save_raid_summary( 0 ), save_gear_comments( 0 ), statistics_level( 1 ), streaming_statistics( false ), separate_stats_by_actions( 0 ), report_raid_summary( 0 ), buff_uptime_timeline( 0 ),
   json_full_states( 0 ),
+  json2_compact( 0 ),
   decorated_tooltips( -1 ),
   allow_potions( true ),
   allow_food( true ),
@@ -1435,7 +1450,7 @@ sim_t::sim_t() :
   enable_dps_healing( false ),
   scaling_normalized( 1.0 ),
   // Multi-Threading
-  threads( 0 ), thread_index( 0 ), process_priority( computer_process::BELOW_NORMAL ),
+  merge_ready( false ), threads( 0 ), thread_index( 0 ), process_priority( computer_process::BELOW_NORMAL ),
   work_queue( new work_queue_t() ),
   spell_query(), spell_query_level( MAX_LEVEL ),
   pause_mutex( nullptr ),
@@ -1449,7 +1464,11 @@ sim_t::sim_t() :
   profileset_output_data(),
   profileset_enabled( false ),
   profileset_work_threads( 0 ),
-  profileset_init_threads( 1 )
+  profileset_init_threads( 1 ),
+  profileset_race( false ),
+  profileset_race_confidence( 0.99 ),
+  profileset_race_iterations( 100 ),
+  profileset_reuse_init( false )
 {
   item_db_sources.assign( std::begin( default_item_db_sources ),
                           std::end( default_item_db_sources ) );
@@ -1486,6 +1505,7 @@ sim_t::sim_t( sim_t* p, int index ) : sim_t()
 
   // While we inherit the parent seed, it may get overwritten in sim_t::init
   seed = parent -> seed;
+  crn_seed = parent -> crn_seed;
 
   parent -> add_relative( this );
 }
@@ -1497,6 +1517,9 @@ sim_t::sim_t( sim_t* p, int index, sim_control_t* control ) : sim_t()
   parent = p;
   thread_index = index;
 
+  // Register before setup, so a setup failure (exception) can unregister in the destructor
+  parent -> add_relative( this );
+
   // Use specialized control for setup
   setup( control );
 
@@ -1513,8 +1536,7 @@ sim_t::sim_t( sim_t* p, int index, sim_control_t* control ) : sim_t()
 
   // While we inherit the parent seed, it may get overwritten in sim_t::init
   seed = parent -> seed;
-
-  parent -> add_relative( this );
+  crn_seed = parent -> crn_seed;
 }
 
 // sim_t::~sim_t ============================================================
@@ -1655,15 +1677,54 @@ void sim_t::combat()
   combat_end();
 }
 
+// sim_t::start_crn_iteration ==============================================
+
+/// Claim the index of the iteration about to start, and seed the sim-wide rng from it. Per-source
+/// streams are reseeded lazily on first use ( see crn_rng() ). The seed only depends on the base
+/// seed and the iteration index, so any iteration can be replayed regardless of thread count.
+void sim_t::start_crn_iteration()
+{
+  crn_iteration = crn_iteration_offset + work_queue -> start( current_index );
+  ++crn_epoch;
+
+  seed = crn_mix( crn_mix( crn_seed ^ crn_mix( current_index ) ) ^ crn_iteration );
+  _rng -> seed( seed );
+  _rng -> reset();
+}
+
+// sim_t::crn_key ===========================================================
+
+/// Stream key for a random number source. Sources sharing a name are told apart by creation order,
+/// which is identical in the sims being compared.
+uint64_t sim_t::crn_key( const std::string& source )
+{
+  if ( ! common_random_numbers )
+    return 0;
+
+  uint64_t h = std::hash<std::string>()( source );
+  return crn_mix( h ^ crn_mix( crn_key_count[ h ]++ ) );
+}
+
+// sim_t::seed_crn_stream ===================================================
+
+void sim_t::seed_crn_stream( crn_stream_t& stream )
+{
+  if ( ! stream.rng )
+  {
+    stream.rng = rng::create( rng::engine_type::PHILOX );
+  }
+
+  stream.rng -> seed( crn_mix( seed ^ stream.key ) );
+  stream.rng -> reset();
+  stream.epoch = crn_epoch;
+}
+
 /// Reset simulation.
 void sim_t::reset()
 {
   if ( debug )
     out_debug << "Resetting Simulator";
 
-  if( deterministic )
-    seed = rng().reseed();
-
   event_mgr.reset();
 
   expected_iteration_time = max_time * iteration_time_adjust();
@@ -1734,10 +1795,12 @@ void sim_t::combat_begin()
   if ( debug )
     out_debug << "Combat Begin";
 
+  if ( common_random_numbers || deterministic )
+    start_crn_iteration();
+
   reset();
 
-  // Debug seed needs to be done _after_ sim reset, because deterministic=1 will reseed in
-  // sim_t::reset()
+  // Debug seed needs to be done _after_ sim reset, so the iteration seed is known
   if ( debug_seed.size() > 0 )
   {
     enable_debug_seed();
@@ -1930,6 +1993,21 @@ void sim_t::datacollection_end()
     }
   }
 
+  // Record the scale metric by iteration index, so scale factors can pair up iterations that used
+  // the same random numbers
+  if ( common_random_numbers )
+  {
+    for ( size_t i = 0; i < player_no_pet_list.size(); ++i )
+    {
+      if ( single_actor_batch && i != current_index )
+        continue;
+
+      player_t* p = player_no_pet_list[ i ];
+      p -> collected_data.crn_scaling_metric.add( crn_iteration,
+          p -> iteration_scaling_for_metric( scaling -> scaling_metric ) );
+    }
+  }
+
   for ( size_t i = 0; i < buff_list.size(); ++i )
   {
     buff_t* b = buff_list[ i ];
@@ -2419,6 +2497,7 @@ bool sim_t::init()
     }
   }
   _rng = rng::create( rng::parse_type( rng_str ) );
+  _rng -> set_buffer_size( rng_buffer );
   _rng -> seed( seed + thread_index );
 
   if (   queue_lag_stddev == timespan_t::zero() )   queue_lag_stddev =   queue_lag * 0.25;
@@ -2686,8 +2765,8 @@ bool sim_t::iterate()
     auto old_active = current_index;
     if ( ! canceled )
     {
-      current_index = work_queue -> pop();
-      more_work = work_queue -> more_work();
+      current_index = work_queue -> pop( work_cursor );
+      more_work = work_queue -> more_work( work_cursor );
 
       if ( more_work && current_index != old_active )
       {
@@ -2755,10 +2834,10 @@ void sim_t::do_pause()
 /// merge sims
 void sim_t::merge( sim_t& other_sim )
 {
-  auto_lock_t auto_lock( merge_mutex );
   auto start = std::chrono::high_resolution_clock::now();
 
-  if ( scaling -> scale_stat == STAT_NONE &&
+  if ( ! parent &&
+       scaling -> scale_stat == STAT_NONE &&
        scaling -> calculate_scale_factors == 0 &&
        plot -> dps_plot_stat_str.empty() &&
        reforge_plot -> reforge_plot_stat_str.empty() &&
@@ -2768,7 +2847,13 @@ void sim_t::merge( sim_t& other_sim )
   }
 
   iterations += other_sim.iterations;
-  work_per_thread[ other_sim.thread_index ] = other_sim.work_done;
+  // Other sim carries the per-thread work of its whole merge subtree, entries are disjoint
+  for ( size_t i = 0; i < work_per_thread.size(); ++i )
+  {
+    work_per_thread[ i ] += other_sim.work_per_thread[ i ];
+    work_claims_per_thread[ i ] += other_sim.work_claims_per_thread[ i ];
+    work_idle_per_thread[ i ] += other_sim.work_idle_per_thread[ i ];
+  }
 
   simulation_length.merge( other_sim.simulation_length );
   total_dmg.merge( other_sim.total_dmg );
@@ -2779,17 +2864,39 @@ void sim_t::merge( sim_t& other_sim )
   raid_aps.merge( other_sim.raid_aps );
   event_mgr.merge( other_sim.event_mgr );
 
-  for ( auto & buff : buff_list )
+  // Sims are set up identically, so buffs and actors are normally found at the same position in
+  // the other sim. Only fall back to lookups if that is not the case.
+  for ( size_t i = 0; i < buff_list.size(); ++i )
   {
-    if ( buff_t* otherbuff = buff_t::find( &other_sim, buff -> name_str.c_str() ) )
+    buff_t* buff = buff_list[ i ];
+    buff_t* otherbuff = nullptr;
+    if ( i < other_sim.buff_list.size() && other_sim.buff_list[ i ] -> name_str == buff -> name_str )
+    {
+      otherbuff = other_sim.buff_list[ i ];
+    }
+    else
+    {
+      otherbuff = buff_t::find( &other_sim, buff -> name_str.c_str() );
+    }
+
+    if ( otherbuff )
     {
       buff -> merge( *otherbuff );
     }
   }
 
-  for ( auto & player : actor_list )
+  for ( size_t i = 0; i < actor_list.size(); ++i )
   {
-    player_t* other_p = other_sim.find_player( player -> index );
+    player_t* player = actor_list[ i ];
+    player_t* other_p = nullptr;
+    if ( i < other_sim.actor_list.size() && other_sim.actor_list[ i ] -> index == player -> index )
+    {
+      other_p = other_sim.actor_list[ i ];
+    }
+    else
+    {
+      other_p = other_sim.find_player( player -> index );
+    }
     assert( other_p );
     player -> merge( *other_p );
   }
@@ -2799,16 +2906,64 @@ void sim_t::merge( sim_t& other_sim )
   init_time += other_sim.init_time;
 }
 
+/**
+ * Pairwise (binomial tree) reduction of the child sims. The sim with thread index i merges the
+ * sims i + 1, i + 2, i + 4, ... for as long as i is a multiple of twice the distance, each after
+ * that sim has merged its own partners. Merging happens concurrently on the sim threads, so the
+ * main thread only performs log2( threads ) merges. A failed sim does not merge its partners, so
+ * they are merged individually by the sim that would have merged the failed one.
+ */
+void sim_t::merge_partners()
+{
+  // Thread 0 of any sim ( including scaling, plot and profileset sims ) owns the children
+  sim_t* root = thread_index == 0 ? this : parent;
+  int n_sims = as<int>( root -> children.size() ) + 1;
+
+  // Sims that failed initialization may not have set up their work statistics
+  work_per_thread.resize( threads );
+  work_claims_per_thread.resize( threads );
+  work_idle_per_thread.resize( threads );
+
+  work_per_thread[ thread_index ] = work_done;
+  work_claims_per_thread[ thread_index ] = work_cursor.claims;
+  work_idle_per_thread[ thread_index ] = work_cursor.idle;
+
+  // Healthy sims merged below a failed partner
+  std::function<void( sim_t* )> merge_subtree = [ & ]( sim_t* partner ) {
+    if ( partner -> merge_ready )
+    {
+      merge( *partner );
+      return;
+    }
+
+    int index = partner -> thread_index;
+    for ( int step = 1; index % ( 2 * step ) == 0 && index + step < n_sims; step *= 2 )
+    {
+      merge_subtree( root -> children[ index + step - 1 ] );
+    }
+  };
+
+  for ( int step = 1; thread_index % ( 2 * step ) == 0 && thread_index + step < n_sims; step *= 2 )
+  {
+    sim_t* partner = root -> children[ thread_index + step - 1 ];
+    partner -> join();
+
+    // Thread 0 always merges, even in cases of unsuccessful simulation
+    if ( thread_index == 0 || merge_ready )
+    {
+      merge_subtree( partner );
+    }
+  }
+}
+
 /// merge all sims together
 void sim_t::merge()
 {
-  work_per_thread[ thread_index ] = work_done;
+  merge_partners();
 
   if ( children.empty() )
     return;
 
-  merge_mutex.unlock();
-
   for ( size_t i = 0; i < children.size(); i++ )
   {
     sim_t* child = children[ i ];
@@ -2830,10 +2985,10 @@ void sim_t::merge()
 
 void sim_t::run()
 {
-  if( iterate() )
-  {
-    parent -> merge( *this );
-  }
+  merge_ready = iterate();
+
+  // Partners are merged (or discarded) even if this sim failed, so they are always joined
+  merge_partners();
 }
 
 // sim_t::partition =========================================================
@@ -2849,8 +3004,6 @@ void sim_t::partition()
 
   thread::set_main_thread_priority();
 
-  merge_mutex.lock(); // parent sim is locked until parent merge() is called
-
   int remainder = iterations % threads;
   iterations /= threads;
 
@@ -2862,6 +3015,10 @@ void sim_t::partition()
   {
     work_queue -> init( iterations );
   }
+  else
+  {
+    work_queue -> workers( threads );
+  }
 
   int num_children = threads - 1;
 
@@ -2878,6 +3035,7 @@ void sim_t::partition()
     child_control = control;
   }
 
+  uint64_t iteration_offset = iterations;
   for ( int i = 0; i < num_children; i++ )
   {
     auto  child = new sim_t( this, i + 1, child_control );
@@ -2895,6 +3053,8 @@ void sim_t::partition()
     if( deterministic || strict_work_queue )
     {
       child -> work_queue -> init( child -> iterations );
+      child -> crn_iteration_offset = iteration_offset;
+      iteration_offset += child -> iterations;
     }
     else // share the work queue
     {
@@ -3192,8 +3352,12 @@ void sim_t::create_options()
   add_option( opt_func( "proxy", parse_proxy ) );
   add_option( opt_int( "auto_ready_trigger", auto_ready_trigger ) );
   add_option( opt_int( "stat_cache", stat_cache ) );
+  add_option( opt_bool( "stat_cache_counters", stat_cache_counters ) );
   add_option( opt_int( "max_aoe_enemies", max_aoe_enemies ) );
+  add_option( opt_bool( "aoe_snapshot_once", aoe_snapshot_once ) );
   add_option( opt_bool( "optimize_expressions", optimize_expressions ) );
+  add_option( opt_bool( "compile_expressions", compile_expressions ) );
+  add_option( opt_bool( "cache_action_readiness", cache_action_readiness ) );
   add_option( opt_bool( "single_actor_batch", single_actor_batch ) );
   add_option( opt_bool( "progressbar_type", progressbar_type ) );
   // Raid buff overrides
@@ -3239,6 +3403,7 @@ void sim_t::create_options()
   add_option( opt_bool( "save_gear_comments", save_gear_comments ) );
   add_option( opt_bool( "buff_uptime_timeline", buff_uptime_timeline ) );
   add_option( opt_bool( "json_full_states", json_full_states ) );
+  add_option( opt_bool( "json2_compact", json2_compact ) );
   // Bloodlust
   add_option( opt_int( "bloodlust_percent", bloodlust_percent ) );
   add_option( opt_timespan( "bloodlust_time", bloodlust_time ) );
@@ -3252,7 +3417,9 @@ void sim_t::create_options()
   add_option( opt_timespan( "regen_periodicity", regen_periodicity ) );
   // RNG
   add_option( opt_string( "rng", rng_str ) );
+  add_option( opt_uint( "rng_buffer", rng_buffer ) );
   add_option( opt_bool( "deterministic", deterministic ) );
+  add_option( opt_bool( "common_random_numbers", common_random_numbers ) );
   add_option( opt_bool( "strict_work_queue", strict_work_queue ) );
   add_option( opt_float( "report_iteration_data", report_iteration_data ) );
   add_option( opt_int( "min_report_iteration_data", min_report_iteration_data ) );
@@ -3266,6 +3433,7 @@ void sim_t::create_options()
   add_option( opt_float( "wheel_granularity", event_mgr.wheel_granularity ) );
   add_option( opt_int( "wheel_seconds", event_mgr.wheel_seconds ) );
   add_option( opt_int( "wheel_shift", event_mgr.wheel_shift ) );
+  add_option( opt_string( "event_queue", event_mgr.queue_str ) );
   add_option( opt_string( "reference_player", reference_player_str ) );
   add_option( opt_string( "raid_events", raid_events_str ) );
   add_option( opt_append( "raid_events+", raid_events_str ) );
@@ -3355,6 +3523,7 @@ void sim_t::create_options()
   add_option( opt_bool( "report_raw_abilities", report_raw_abilities ) );
   add_option( opt_bool( "report_rng", report_rng ) );
   add_option( opt_int( "statistics_level", statistics_level ) );
+  add_option( opt_bool( "streaming_statistics", streaming_statistics ) );
   add_option( opt_bool( "separate_stats_by_actions", separate_stats_by_actions ) );
   add_option( opt_bool( "report_raid_summary", report_raid_summary ) ); // Force reporting of raid summary
   add_option( opt_string( "reforge_plot_output_file", reforge_plot_output_file_str ) );
@@ -3413,10 +3582,10 @@ bool sim_t::parse_option( const std::string& name,
                           const std::string& value )
 {
   if ( active_player )
-    if ( opts::parse( this, active_player -> options, name, value ) )
+    if ( opts::parse( this, active_player -> options, active_player -> option_index, name, value ) )
       return true;
 
-  if ( opts::parse( this, options, name, value ) )
+  if ( opts::parse( this, options, option_index, name, value ) )
     return true;
 
   return false;
@@ -3467,7 +3636,7 @@ void sim_t::setup( sim_control_t* c )
       s << "Unable to locate player '" << o.scope << "' for option '" << o.name << "' with value '" << o.value << "'";
       throw std::invalid_argument( s.str() );
     }
-    if ( ! opts::parse(this, p->options, o.name, o.value))
+    if ( ! opts::parse( this, p -> options, p -> option_index, o.name, o.value ) )
     {
       std::stringstream s;
       s << "Unable to parse option '" << o.name << "' with value '" << o.value
@@ -3482,6 +3651,18 @@ void sim_t::setup( sim_control_t* c )
     throw std::runtime_error( "Nothing to sim!" );
   }
 
+  // Common random numbers and deterministic sims need a base seed shared by all threads and child
+  // sims, fixed before any of them is created
+  if ( ( common_random_numbers || deterministic ) && ! parent )
+  {
+    if ( seed == 0 )
+    {
+      std::random_device rd;
+      seed = deterministic ? 31459 : uint64_t( rd() ) | ( uint64_t( rd() ) << 32 );
+    }
+    crn_seed = seed;
+  }
+
   if ( parent )
   {
     debug = 0;
@@ -3523,6 +3704,13 @@ void sim_t::setup( sim_control_t* c )
     threads = 1;
   }
 
+  // The thread budget of the main sim caps the process-wide thread pool, child sims (threads,
+  // scaling, plots, profilesets) split the budget between them
+  if ( ! parent )
+  {
+    thread::set_pool_size( as<size_t>( threads ) );
+  }
+
   if ( iterations <= 0 )
   {
     iterations = 1000000; // limited by relative standard error
@@ -3559,10 +3747,9 @@ void sim_t::setup( sim_control_t* c )
     work_queue -> batches( player_no_pet_list.size() );
   }
   work_queue -> init( iterations );
-  if ( thread_index == 0 )
-  {
-    work_per_thread.resize( threads );
-  }
+  work_per_thread.assign( threads, 0 );
+  work_claims_per_thread.assign( threads, 0 );
+  work_idle_per_thread.assign( threads, 0 );
 
   if( deterministic && ( target_error != 0 ) )
   {
@@ -3687,10 +3874,20 @@ void sim_t::abort()
   std::terminate();
 }
 
+namespace {
+// Report sections rendered concurrently collect their charts here, to be added in report order
+thread_local sim_t::chart_data_list_t* chart_data_redirect = nullptr;
+}
+
 /// add chart to sim for end of report processing
 void sim_t::add_chart_data( const highchart::chart_t& chart )
 {
-  if ( chart.toggle_id_str_.empty() )
+  if ( chart_data_redirect )
+  {
+    chart_data_redirect -> push_back( std::make_pair( chart.toggle_id_str_,
+      chart.toggle_id_str_.empty() ? chart.to_aggregate_string( false ) : chart.to_data() ) );
+  }
+  else if ( chart.toggle_id_str_.empty() )
   {
     on_ready_chart_data.push_back( chart.to_aggregate_string( false ) );
   }
@@ -3700,6 +3897,26 @@ void sim_t::add_chart_data( const highchart::chart_t& chart )
   }
 }
 
+void sim_t::add_chart_data( const chart_data_list_t& charts )
+{
+  for ( const auto& chart : charts )
+  {
+    if ( chart.first.empty() )
+    {
+      on_ready_chart_data.push_back( chart.second );
+    }
+    else
+    {
+      chart_data[ chart.first ].push_back( chart.second );
+    }
+  }
+}
+
+void sim_t::redirect_chart_data( chart_data_list_t* list )
+{
+  chart_data_redirect = list;
+}
+
 void sim_t::print_spell_query()
 {
   if ( ! spell_query_xml_output_file_str.empty() )
@@ -3730,20 +3947,19 @@ std::vector<double> sc_timeline_t::build_divisor_timeline( const extended_sample
   size_t max_buckets = static_cast<size_t>( floor( simulation_length.max() / bin_size ) + 1);
   divisor_timeline.assign( max_buckets, 0.0 );
 
+  static const bool use_old_behaviour = true;
+
   size_t num_timelines = simulation_length.data().size();
   for ( size_t i = 0; i < num_timelines; i++ )
   {
     size_t last = static_cast<size_t>( floor( simulation_length.data()[ i ] / bin_size ) );
     assert( last < divisor_timeline.size() ); // We created it with max length
 
-    static const bool use_old_behaviour = true;
     if ( use_old_behaviour )
     {
-      // Add all visited buckets.
-      for ( size_t j = 0; j <= last; j++ )
-      {
-        divisor_timeline[ j ] += 1.0;
-      }
+      // All buckets up to the last one are visited. Only count where the iteration ended here, the
+      // counts are accumulated from the back below, instead of touching every bucket per iteration.
+      divisor_timeline[ last ] += 1.0;
     }
     else
     {
@@ -3763,6 +3979,14 @@ std::vector<double> sc_timeline_t::build_divisor_timeline( const extended_sample
     }
   }
 
+  if ( use_old_behaviour )
+  {
+    for ( size_t j = divisor_timeline.size() - 1; j > 0; j-- )
+    {
+      divisor_timeline[ j - 1 ] += divisor_timeline[ j ];
+    }
+  }
+
   return divisor_timeline;
 }
 
@@ -3963,3 +4187,189 @@ bool sim_t::requires_cleanup() const
   // .. or finally, clean up child threads based on the "cleanup_threads" option value
   return cleanup_threads;
 }
+
+// ==========================================================================
+// Child Sim Batch
+// ==========================================================================
+
+child_sim_batch_t::child_sim_batch_t( sim_t* p ) :
+  parent( p ), control(), total( 0 ), started( 0 ), finished( 0 ),
+  finished_iterations( 0 ), estimated_iterations( 0 )
+{ }
+
+// child_sim_batch_t::execute ===============================================
+
+void child_sim_batch_t::execute( size_t n, size_t concurrency, const create_fn_t& create, const done_fn_t& done )
+{
+  if ( n == 0 )
+  {
+    return;
+  }
+
+  int total_threads = std::max( 1, parent -> threads );
+  if ( concurrency == 0 )
+  {
+    concurrency = as<size_t>( total_threads );
+  }
+  size_t n_workers = std::min( n, std::max( concurrency, as<size_t>( 1 ) ) );
+  int sim_threads = std::max( 1, total_threads / as<int>( n_workers ) );
+
+  // Children get their share of the thread budget as an option, so setup() already sizes the
+  // per-thread state of the child sim for it. The options outlive the batch, as the caller may keep
+  // the child sims.
+  control = *parent -> control;
+  if ( n_workers > 1 )
+  {
+    control.options.add( "global", "threads", util::to_string( sim_threads ) );
+  }
+
+  mutex.lock();
+  total = n;
+  started = finished = 0;
+  finished_iterations = 0;
+  // The (finished) parent sim serves as the estimate for children that have not started yet
+  estimated_iterations = parent -> progress().total_iterations;
+  running.clear();
+  mutex.unlock();
+
+  // Errors of the children are rethrown once all workers are done, the first one wins
+  std::exception_ptr error;
+
+  auto worker = [ & ]() {
+    while ( ! parent -> is_canceled() )
+    {
+      size_t index;
+      {
+        AUTO_LOCK( mutex );
+        if ( started == total || error )
+        {
+          break;
+        }
+        index = started++;
+      }
+
+      std::unique_ptr<sim_t> child;
+      try
+      {
+        child.reset( create( index, &control ) );
+        if ( n_workers > 1 )
+        {
+          // Progress of the whole batch is reported by the parent instead
+          child -> report_progress = 0;
+        }
+
+        mutex.lock();
+        running.push_back( child.get() );
+        mutex.unlock();
+
+        child -> execute();
+
+        mutex.lock();
+        running.erase( range::find( running, child.get() ) );
+        finished_iterations += child -> progress().total_iterations;
+        finished++;
+        mutex.unlock();
+
+        if ( ! parent -> is_canceled() )
+        {
+          done( index, child );
+        }
+      }
+      catch ( ... )
+      {
+        AUTO_LOCK( mutex );
+        if ( child )
+        {
+          auto it = range::find( running, child.get() );
+          if ( it != running.end() )
+          {
+            running.erase( it );
+          }
+        }
+        if ( ! error )
+        {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+
+  if ( n_workers == 1 )
+  {
+    worker();
+  }
+  else
+  {
+    thread::task_group_t workers;
+    for ( size_t i = 0; i < n_workers; ++i )
+    {
+      workers.run( worker );
+    }
+
+    // The calling thread draws the progress bar of the whole batch until the workers are done
+    while ( ! workers.wait_for( 0.25 ) )
+    {
+      if ( ! parent -> is_canceled() && parent -> progress_bar.update( progress(), false ) )
+      {
+        parent -> progress_bar.output( false );
+      }
+    }
+    workers.wait();
+
+    if ( ! error && ! parent -> is_canceled() && parent -> progress_bar.update( progress(), true ) )
+    {
+      parent -> progress_bar.output( true );
+    }
+  }
+
+  mutex.lock();
+  total = 0;
+  mutex.unlock();
+
+  if ( error )
+  {
+    std::rethrow_exception( error );
+  }
+}
+
+// child_sim_batch_t::progress ==============================================
+
+sim_progress_t child_sim_batch_t::progress()
+{
+  AUTO_LOCK( mutex );
+
+  sim_progress_t progress { finished_iterations, as<int>( total - started ) * estimated_iterations };
+  progress.total_iterations += finished_iterations;
+  for ( auto child : running )
+  {
+    auto child_progress = child -> progress();
+    progress.current_iterations += child_progress.current_iterations;
+    progress.total_iterations += child_progress.total_iterations;
+  }
+
+  return progress;
+}
+
+// child_sim_batch_t::active ================================================
+
+bool child_sim_batch_t::active()
+{
+  AUTO_LOCK( mutex );
+  return total > 0;
+}
+
+// child_sim_batch_t::size ==================================================
+
+size_t child_sim_batch_t::size()
+{
+  AUTO_LOCK( mutex );
+  return total;
+}
+
+// child_sim_batch_t::completed =============================================
+
+size_t child_sim_batch_t::completed()
+{
+  AUTO_LOCK( mutex );
+  return finished;
+}
@@ -568,6 +568,71 @@ using buff_tick_time_callback_t = std::function<timespan_t(const buff_t*, unsign
 using buff_refresh_duration_callback_t = std::function<timespan_t(const buff_t*, const timespan_t&)>;
 using buff_stack_change_callback_t = std::function<void(buff_t*, int, int)>;
 
+// Common Random Numbers ====================================================
+
+/**
+ * Per-source random number stream, used with common_random_numbers=1.
+ *
+ * The stream is reseeded on first use in each iteration from the sim seed, the
+ * iteration index, and the source key, so a source draws the same numbers in
+ * the same iteration of two sims, regardless of how many numbers other sources
+ * drew before it.
+ */
+struct crn_stream_t
+{
+  std::unique_ptr<rng::rng_t> rng;
+  uint64_t key;
+  uint64_t epoch;
+
+  crn_stream_t() : key( 0 ), epoch( 0 )
+  { }
+};
+
+/**
+ * Streaming per-iteration scale metric, used with common_random_numbers=1.
+ *
+ * Iterations are summed into a fixed number of batches by iteration index. The
+ * baseline and delta sims of a scale factor cover the same iterations of each
+ * batch, so their per-batch differences can be paired (batch means) without
+ * keeping every iteration around.
+ */
+struct crn_batch_means_t
+{
+  static const unsigned N_BATCHES = 64;
+
+  std::array<uint64_t, N_BATCHES> count;
+  std::array<uint64_t, N_BATCHES> index_sum;
+  std::array<double, N_BATCHES> sum;
+
+  crn_batch_means_t()
+  {
+    count.fill( 0 );
+    index_sum.fill( 0 );
+    sum.fill( 0 );
+  }
+
+  void add( uint64_t index, double value )
+  {
+    if ( std::isnan( value ) )
+      return;
+
+    unsigned batch = index % N_BATCHES;
+    ++count[ batch ];
+    index_sum[ batch ] += index;
+    sum[ batch ] += value;
+  }
+
+  void merge( const crn_batch_means_t& other )
+  {
+    for ( unsigned i = 0; i < N_BATCHES; ++i )
+    {
+      count[ i ] += other.count[ i ];
+      index_sum[ i ] += other.index_sum[ i ];
+      sum[ i ] += other.sum[ i ];
+    }
+  }
+};
+
 // Buff Creation ====================================================================
 namespace buff_creation {
 
@@ -833,6 +898,7 @@ public:
   // dynamic values
   double current_value;
   int current_stack;
+  uint64_t stack_version; /// Bumped on every current_stack change
   timespan_t buff_duration;
   double default_chance;
   std::vector<timespan_t> stack_react_time;
@@ -1011,6 +1077,7 @@ public:
   std::string source_name() const;
   int max_stack() const { return _max_stack; }
 
+  crn_stream_t crn_stream;
   rng::rng_t& rng();
 
   bool change_regen_rate;
@@ -1316,6 +1383,7 @@ struct progress_bar_t
   progress_bar_t( sim_t& s );
   void init();
   bool update( bool finished = false, int index = -1 );
+  bool update( const sim_progress_t& progress, bool finished );
   void output( bool finished = false );
   void restart();
   void progress();
@@ -1494,29 +1562,71 @@ struct event_manager_t
   uint64_t max_events_remaining;
   unsigned timing_slice, global_event_id;
   std::vector<event_t*> timing_wheel;
-  event_t* recycled_event_list;
   int    wheel_seconds, wheel_size, wheel_mask, wheel_shift;
   double wheel_granularity;
   timespan_t wheel_time;
+
+  // Event allocator. Events are carved out of slabs in power-of-two size
+  // classes (64 to 2048 bytes), and recycled per size class. Slabs are aligned
+  // to their size, and start with a cache line header holding their size
+  // class, so the class of any event is found from its address. Slabs are
+  // owned by the (per-thread) event manager and freed in bulk on destruction.
+  static const unsigned EVENT_MIN_SIZE_SHIFT = 6;
+  static const unsigned EVENT_SIZE_CLASSES = 6;
+  static const std::size_t EVENT_MAX_SIZE = std::size_t( 1 ) << ( EVENT_MIN_SIZE_SHIFT + EVENT_SIZE_CLASSES - 1 );
+  static const std::size_t EVENT_SLAB_SIZE = 64 * 1024;
+  static const std::size_t EVENT_SLAB_HEADER = 64;
+  struct event_size_class_t
+  {
+    event_t* recycled;
+    char* slab_cur;
+    char* slab_end;
+    uint64_t requested, allocated;
+  };
+  std::array<event_size_class_t, EVENT_SIZE_CLASSES> event_size_classes;
+  std::vector<void*> event_slabs;
   std::vector<event_t*> allocated_events;
 
+  // Event queue backend, selected with the event_queue= option
+  enum queue_type_e { QUEUE_WHEEL, QUEUE_HIERARCHICAL };
+  std::string queue_str;
+  queue_type_e queue_type;
+
+  // Hierarchical timing wheel (event_queue=hierarchical). Level 0 has a
+  // granularity of one millisecond, each subsequent level covers the full
+  // range of the previous one in a single slot.
+  static const unsigned HW_LEVELS = 4;
+  static const unsigned HW_SHIFT = 8;
+  static const unsigned HW_SLOTS = 1U << HW_SHIFT;
+  std::vector<event_t*> hw_head, hw_tail;
+  std::vector<uint64_t> hw_occupied;
+  int64_t hw_time;
+
   stopwatch_t event_stopwatch;
   bool monitor_cpu;
   bool canceled;
 #ifdef EVENT_QUEUE_DEBUG
-  unsigned max_queue_depth, n_allocated_events, n_end_insert, n_requested_events;
+  unsigned max_queue_depth, n_end_insert;
   uint64_t events_traversed, events_added;
   std::vector<std::pair<unsigned, unsigned> > event_queue_depth_samples;
-  std::vector<unsigned> event_requested_size_count;
 #endif /* EVENT_QUEUE_DEBUG */
 
   event_manager_t( sim_t* );
  ~event_manager_t();
   void* allocate_event( std::size_t size );
   void recycle_event( event_t* );
+  static constexpr unsigned event_size_class( std::size_t size, unsigned c = 0 )
+  {
+    return size <= ( std::size_t( 1 ) << ( EVENT_MIN_SIZE_SHIFT + c ) ) ? c : event_size_class( size, c + 1 );
+  }
   void add_event( event_t*, timespan_t delta_time );
   void reschedule_event( event_t* );
   event_t* next_event();
+  void insert_wheel( event_t* );
+  void insert_hierarchical( event_t* );
+  event_t* next_event_wheel();
+  event_t* next_event_hierarchical();
+  const char* queue_name() const;
   bool execute();
   void cancel();
   void flush();
@@ -1584,7 +1694,7 @@ struct sim_t : private sc_thread_t
   double      travel_variance, default_skill;
   timespan_t  reaction_time, regen_periodicity;
   timespan_t  ignite_sampling_delta;
-  bool        fixed_time, optimize_expressions;
+  bool        fixed_time, optimize_expressions, compile_expressions, cache_action_readiness;
   int         current_slot;
   int         optimal_raid, log, debug_each;
   std::vector<uint64_t> debug_seed;
@@ -1597,7 +1707,9 @@ struct sim_t : private sc_thread_t
   std::string main_target_str;
   int         auto_ready_trigger;
   int         stat_cache;
+  bool        stat_cache_counters;
   int         max_aoe_enemies;
+  bool        aoe_snapshot_once; // Snapshot source side state of aoe actions once per execute
   bool        show_etmi;
   double      tmi_window_global;
   double      tmi_bin_size;
@@ -1642,14 +1754,23 @@ struct sim_t : private sc_thread_t
 
   std::unordered_map<std::string, std::string> var_map;
   std::vector<std::unique_ptr<option_t>> options;
+  opts::option_index_t option_index;
   std::vector<std::string> party_encoding;
   std::vector<std::string> item_db_sources;
 
   // Random Number Generation
   std::unique_ptr<rng::rng_t> _rng;
   std::string rng_str;
+  unsigned rng_buffer; // Bulk buffer size of the sim-wide rng, 0 disables buffering
   uint64_t seed;
   int deterministic;
+  // Common random numbers ( see crn_stream_t ), crn_iteration is the index of the current
+  // iteration, shared by all threads, crn_epoch counts iterations started by this sim.
+  // Deterministic sims use the same per-iteration seeding, with crn_iteration_offset giving each
+  // thread's private work queue a disjoint range of iteration indices.
+  bool common_random_numbers;
+  uint64_t crn_seed, crn_iteration, crn_iteration_offset, crn_epoch;
+  std::unordered_map<uint64_t, unsigned> crn_key_count;
   int strict_work_queue;
   int average_range, average_gauss;
   int convergence_scale;
@@ -1723,7 +1844,7 @@ struct sim_t : private sc_thread_t
   std::unique_ptr<reforge_plot_t> reforge_plot;
   double elapsed_cpu;
   double elapsed_time;
-  std::vector<size_t> work_per_thread;
+  std::vector<size_t> work_per_thread, work_claims_per_thread, work_idle_per_thread;
   size_t work_done;
   double     iteration_dmg, priority_iteration_dmg,  iteration_heal, iteration_absorb;
   simple_sample_data_t raid_dps, total_dmg, raid_hps, total_heal, total_absorb, raid_aps;
@@ -1766,10 +1887,12 @@ struct sim_t : private sc_thread_t
   int save_raid_summary;
   int save_gear_comments;
   int statistics_level;
+  bool streaming_statistics; // Constant-memory sample data ( no per-iteration samples retained )
   int separate_stats_by_actions;
   int report_raid_summary;
   int buff_uptime_timeline;
   int json_full_states;
+  int json2_compact; // Write the json2 report without indentation
   int decorated_tooltips;
 
   int allow_potions;
@@ -1785,92 +1908,176 @@ struct sim_t : private sc_thread_t
   double scaling_normalized;
 
   // Multi-Threading
-  mutex_t merge_mutex;
+  bool merge_ready; // Child sim finished iterating successfully, and can be merged
   int threads;
   std::vector<sim_t*> children; // Manual delete!
   int thread_index;
   computer_process::priority_e process_priority;
   struct work_queue_t
   {
+    // Per-thread claim state. Iterations are claimed from the shared queue in chunks, and the
+    // claimed chunk is consumed without further claims. A flush invalidates claimed chunks.
+    struct cursor_t
+    {
+      size_t index;
+      int remaining;
+      uint32_t epoch;
+      size_t claims, idle;
+
+      cursor_t() : index( 0 ), remaining( 0 ), epoch( 0 ), claims( 0 ), idle( 0 )
+      { }
+    };
+
     private:
-    std::recursive_mutex m;
-    using G = std::lock_guard<std::recursive_mutex>;
+    // Only serializes target_error analysis (analyze_error), work distribution is lock-free
+    std::mutex m;
+    static const int MAX_CHUNK = 32;
+
+    using counters_t = std::vector<std::atomic<int>>;
+    // Claimed iterations ( low 32 bits ) and flush epoch ( high 32 bits ) of each index, in one
+    // word so a claim fails atomically once the index has been flushed
+    using claims_t = std::vector<std::atomic<uint64_t>>;
+    counters_t _total_work, _done, _projected_work, _started;
+    claims_t _claimed;
+    std::atomic<size_t> _index;
+    int _workers;
+
+    static int claimed( uint64_t s ) { return static_cast<int>( s & 0xFFFFFFFF ); }
+    static uint32_t epoch( uint64_t s ) { return static_cast<uint32_t>( s >> 32 ); }
+
+    // Move on to the next index (single actor batch) once index i is exhausted
+    void advance( size_t i )
+    {
+      if ( i < _claimed.size() - 1 )
+      {
+        _index.compare_exchange_strong( i, i + 1 );
+      }
+    }
+
+    // Guided self-scheduling, chunk size shrinks as the remaining work shrinks
+    int chunk( int remaining ) const
+    {
+      int n = remaining / ( 4 * _workers );
+      return n < 1 ? 1 : n > MAX_CHUNK ? MAX_CHUNK : n;
+    }
+
     public:
-    std::vector<int> _total_work, _work, _projected_work;
-    size_t index;
+    work_queue_t() : _total_work( 1 ), _done( 1 ), _projected_work( 1 ), _started( 1 ), _claimed( 1 ),
+      _index( 0 ), _workers( 1 )
+    { }
 
-    work_queue_t() : index( 0 )
-    { _total_work.resize( 1 ); _work.resize( 1 ); _projected_work.resize( 1 ); }
+    size_t index() const { return _index.load(); }
 
-    void init( int w )    { G l(m); range::fill( _total_work, w ); range::fill( _projected_work, w ); }
+    void init( int w )
+    {
+      for ( size_t i = 0; i < _total_work.size(); ++i )
+      {
+        _total_work[ i ] = w;
+        _projected_work[ i ] = w;
+        _started[ i ] = 0;
+      }
+    }
     // Single actor batch sim init methods. Batches is the number of active actors
-    void batches( size_t n ) { G l(m); _total_work.resize( n ); _work.resize( n ); _projected_work.resize( n ); }
-
-    void flush()          { G l(m); _total_work[ index ] = _projected_work[ index ] = _work[ index ]; }
-    int  size()           { G l(m); return index < _total_work.size() ? _total_work[ index ] : _total_work.back(); }
-    bool more_work()      { G l(m); return index < _total_work.size() && _work[ index ] < _total_work[ index ]; }
+    void batches( size_t n )
+    {
+      _total_work = counters_t( n ); _done = counters_t( n ); _projected_work = counters_t( n );
+      _started = counters_t( n ); _claimed = claims_t( n );
+    }
+    // Claim a unique, queue-wide ordinal for an iteration started on index i. Used to line up the
+    // iterations of different sims in common random numbers mode.
+    int start( size_t i )
+    { return _started[ std::min( i, _started.size() - 1 ) ]++; }
+    // Number of threads sharing the queue, used to size the claimed chunks
+    void workers( int n ) { _workers = std::max( 1, n ); }
+
+    // Stop at the iterations completed so far. Chunks claimed before the flush are void.
+    void flush()
+    {
+      size_t i = index();
+      _total_work[ i ] = _projected_work[ i ] = _done[ i ].load();
+      _claimed[ i ] += uint64_t( 1 ) << 32;
+    }
+    int  size()           { size_t i = index(); return i < _total_work.size() ? _total_work[ i ].load() : _total_work.back().load(); }
+    bool more_work()      { size_t i = index(); return i < _total_work.size() && claimed( _claimed[ i ] ) < _total_work[ i ]; }
+    bool more_work( const cursor_t& c )
+    { return ( c.remaining > 0 && c.epoch == epoch( _claimed[ c.index ] ) ) || more_work(); }
     void lock()           { m.lock(); }
     void unlock()         { m.unlock(); }
 
     void project( int w )
     {
-      G l(m);
-      _projected_work[ index ] = w;
-#ifdef NDEBUG
-      if ( w > _work[ index ] )
-      {
-      }
-#endif
+      _projected_work[ index() ] = w;
     }
 
-    // Single-actor batch pop, uses several indices of work (per active actor), each thread has it's
-    // own state on what index it is simulating
-    size_t pop()
+    // Account one finished unit of work (iteration) for the calling thread, claiming a new chunk
+    // from the shared queue if the thread has no claimed work left. Single-actor batch uses several
+    // indices of work (per active actor), the returned value is the index the thread should
+    // simulate next.
+    size_t pop( cursor_t& c )
     {
-      G l(m);
+      if ( c.remaining > 0 && c.epoch == epoch( _claimed[ c.index ] ) )
+      {
+        _done[ c.index ]++;
+        return --c.remaining > 0 ? c.index : index();
+      }
+
+      c.remaining = 0;
 
-      if ( _work[ index ] >= _total_work[ index ] )
+      while ( true )
       {
-        if ( index < _work.size() - 1 )
+        size_t i = index();
+        uint64_t s = _claimed[ i ];
+        int total = _total_work[ i ];
+        int w = claimed( s );
+
+        if ( w >= total )
         {
-          ++index;
+          advance( i );
+          c.idle++;
+          return index();
         }
-        return index;
-      }
 
-      if ( ++_work[ index ] == _total_work[ index ] )
-      {
-        _projected_work[ index ] = _work[ index ];
-        if ( index < _work.size() - 1 )
+        // The claim covers the iteration just finished, and n - 1 iterations to come
+        int n = std::min( chunk( total - w ), total - w );
+        if ( _claimed[ i ].compare_exchange_weak( s, s + n ) )
         {
-          ++index;
+          _done[ i ]++;
+          c.claims++;
+          c.index = i;
+          c.remaining = n - 1;
+          c.epoch = epoch( s );
+
+          if ( w + n == total )
+          {
+            _projected_work[ i ] = total;
+            advance( i );
+          }
+
+          return c.remaining > 0 ? i : index();
         }
-        return index;
       }
-
-      return index;
     }
 
     // Standard progress method, normal mode sims use the single (first) index, single actor batch
     // sims progress with the main thread's current index.
     sim_progress_t progress( int idx = -1 )
     {
-      G l(m);
       size_t current_index = idx;
       if ( idx < 0 )
       {
-        current_index = index;
+        current_index = index();
       }
 
       if ( current_index >= _total_work.size() )
       {
-        return sim_progress_t{ _work.back(), _projected_work.back() };
+        return sim_progress_t{ _done.back(), _projected_work.back() };
       }
 
-      return sim_progress_t{ _work[ current_index ], _projected_work[ current_index ] };
+      return sim_progress_t{ _done[ current_index ], _projected_work[ current_index ] };
     }
   };
   std::shared_ptr<work_queue_t> work_queue;
+  work_queue_t::cursor_t work_cursor;
 
   // Related Simulations
   mutex_t relatives_mutex;
@@ -1911,6 +2118,13 @@ struct sim_t : private sc_thread_t
   std::vector<std::string> profileset_output_data;
   bool profileset_enabled;
   int profileset_work_threads, profileset_init_threads;
+  // Profileset racing: screen profilesets in rounds of increasing iterations, and eliminate
+  // profilesets that are statistically worse than the leader
+  bool profileset_race;
+  double profileset_race_confidence;
+  int profileset_race_iterations;
+  // Keep the sims initialized by profileset validation, and simulate the profilesets with them
+  bool profileset_reuse_init;
 
   sim_t();
   sim_t( sim_t* parent, int thread_index = 0 );
@@ -1941,6 +2155,7 @@ struct sim_t : private sc_thread_t
   bool      init();
   void      analyze();
   void      merge( sim_t& other_sim );
+  void      merge_partners();
   void      merge();
   bool      iterate();
   void      partition();
@@ -1964,6 +2179,11 @@ struct sim_t : private sc_thread_t
   void combat_begin();
   void combat_end();
   void add_chart_data( const highchart::chart_t& chart );
+  // Chart data as ( toggle id, data ) pairs, an empty toggle id denoting an on-ready chart
+  using chart_data_list_t = std::vector<std::pair<std::string, std::string>>;
+  void add_chart_data( const chart_data_list_t& charts );
+  // Collect the chart data added by the calling thread into list instead, until reset with nullptr
+  static void redirect_chart_data( chart_data_list_t* list );
   bool      has_raid_event( const std::string& name ) const;
 
   // Activates the necessary actor/actors before iteration begins.
@@ -1977,6 +2197,16 @@ struct sim_t : private sc_thread_t
   { target_data_initializer.push_back( cb ); }
   rng::rng_t& rng() const
   { return *_rng; }
+  rng::rng_t& crn_rng( crn_stream_t& stream )
+  {
+    if ( stream.epoch != crn_epoch )
+    {
+      seed_crn_stream( stream );
+    }
+    return *stream.rng;
+  }
+  uint64_t crn_key( const std::string& source );
+  void seed_crn_stream( crn_stream_t& stream );
   double averaged_range( double min, double max )
   {
     if ( average_range ) return ( min + max ) / 2.0;
@@ -1989,6 +2219,7 @@ struct sim_t : private sc_thread_t
 private:
   void do_pause();
   void print_spell_query();
+  void start_crn_iteration();
   void enable_debug_seed();
   void disable_debug_seed();
   bool requires_cleanup() const;
@@ -2070,6 +2301,35 @@ struct module_t
   }
 };
 
+// Child Sim Batch ==========================================================
+
+// Creates and executes a number of child sims of a parent concurrently, splitting the thread budget
+// of the parent between them. With a concurrency of one the children run in turn with the full
+// budget, and report their own progress as they always have.
+struct child_sim_batch_t
+{
+  // Construct the i-th child sim from the given options, which carry its share of the thread budget
+  using create_fn_t = std::function<sim_t*( size_t, sim_control_t* )>;
+  // Consume the results of the i-th child sim, the sim is deleted unless ownership is taken
+  using done_fn_t = std::function<void( size_t, std::unique_ptr<sim_t>& )>;
+
+  child_sim_batch_t( sim_t* parent );
+
+  void execute( size_t n, size_t concurrency, const create_fn_t& create, const done_fn_t& done );
+  sim_progress_t progress();
+  bool active();
+  size_t size();
+  size_t completed();
+
+private:
+  sim_t* parent;
+  sim_control_t control;
+  mutex_t mutex;
+  std::vector<sim_t*> running;
+  size_t total, started, finished;
+  int finished_iterations, estimated_iterations;
+};
+
 // Scaling ==================================================================
 
 struct scaling_t
@@ -2091,12 +2351,15 @@ struct scaling_t
   double scale_factor_noise;
   int    normalize_scale_factors;
   int    debug_scale_factors;
+  int    concurrent_scale_factors;
   std::string scale_only_str;
   stat_e current_scaling_stat;
   int num_scaling_stats, remaining_scaling_stats;
   std::string scale_over;
   scale_metric_e scaling_metric;
   std::string scale_over_player;
+  // Delta and reference sims of a concurrent scale factor run
+  child_sim_batch_t batch;
 
   // Gear delta for determining scale factors
   gear_stats_t stats;
@@ -2106,6 +2369,8 @@ struct scaling_t
   void init_deltas();
   void analyze();
   void analyze_stats();
+  void analyze_stats_concurrent( const std::vector<stat_e>& );
+  void analyze_stat( stat_e, double, bool, sim_t*, sim_t* );
   void analyze_ability_stats( stat_e, double, player_t*, player_t*, player_t* );
   void analyze_lag();
   void normalize();
@@ -2116,6 +2381,13 @@ struct scaling_t
 
 // Plot =====================================================================
 
+struct plot_data_t
+{
+  double plot_step;
+  double value;
+  double error;
+};
+
 struct plot_t
 {
 public:
@@ -2129,12 +2401,15 @@ public:
   stat_e current_plot_stat;
   int    num_plot_stats, remaining_plot_stats, remaining_plot_points;
   bool   dps_plot_positive, dps_plot_negative;
+  bool   dps_plot_concurrent, dps_plot_adaptive;
+  child_sim_batch_t batch;
 
   plot_t( sim_t* s );
   void analyze();
   double progress( std::string& phase, std::string* detailed = nullptr );
 private:
   void analyze_stats();
+  void evaluate_points( stat_e, const std::vector<int>&, std::map<int, std::vector<plot_data_t>>& );
   void write_output_file();
   void create_options();
 };
@@ -2144,7 +2419,6 @@ private:
 struct reforge_plot_t
 {
   sim_t* sim;
-  sim_t* current_reforge_sim;
   std::string reforge_plot_stat_str;
   std::vector<stat_e> reforge_plot_stat_indices;
   int    reforge_plot_step;
@@ -2152,8 +2426,11 @@ struct reforge_plot_t
   int    reforge_plot_iterations;
   double reforge_plot_target_error;
   int    reforge_plot_debug;
+  // 0 while the sims of the reforge plot run, -1 otherwise
   int    current_stat_combo;
   int    num_stat_combos;
+  int    reforge_plot_concurrent;
+  child_sim_batch_t batch;
 
   reforge_plot_t( sim_t* s );
 
@@ -2169,13 +2446,6 @@ private:
   void create_options();
 };
 
-struct plot_data_t
-{
-  double plot_step;
-  double value;
-  double error;
-};
-
 // Event ====================================================================
 //
 // core_event_t is designed to be a very simple light-weight event transporter and
@@ -2266,6 +2536,8 @@ inline Event* make_event( sim_t& sim, Args&&... args )
 {
   static_assert( std::is_base_of<event_t, Event>::value,
                  "Event must be derived from event_t" );
+  static_assert( sizeof( Event ) <= event_manager_t::EVENT_MAX_SIZE,
+                 "Event is larger than the largest event allocator size class" );
   auto r = new ( sim ) Event( args... );
   assert( r -> id != 0 && "Event not added to event manager!" );
   return r;
@@ -3190,6 +3462,7 @@ struct cooldown_t
   double recharge_multiplier;
   bool hasted; // Hasted cooldowns will reschedule based on haste state changing (through buffs). TODO: Separate hastes?
   action_t* action; // Dynamic cooldowns will need to know what action triggered the cd
+  uint64_t version; // Bumped on every ready or current_charge change
 
   cooldown_t( const std::string& name, player_t& );
   cooldown_t( const std::string& name, sim_t& );
@@ -3259,7 +3532,10 @@ struct effect_callbacks_t
 
   proc_array_t procs;
 
-  effect_callbacks_t( sim_t* sim ) : sim( sim )
+  // Incremented whenever a callback is registered, invalidates per-action callback lists
+  unsigned version;
+
+  effect_callbacks_t( sim_t* sim ) : sim( sim ), version( 0 )
   { }
 
   bool has_callback( const std::function<bool(const T_CB*)> cmp ) const
@@ -3295,17 +3571,33 @@ private:
  * - Same goes for stat_buff_t, which works through player_t::stat_gain/loss
  * - Buffs with effects in a composite_ function need invalidates added to their buff_creator
  *
+ * Invalidating a cache also invalidates its dependents ( eg. Strength invalidates Attack Power ), in
+ * a single store of a precomputed closure mask ( player_t::cache_closure ).
+ *
  * To create invalidation chains ( eg. Priest: Spirit invalidates Hit ) override the
- * virtual player_t::invalidate_cache( cache_e ) function.
+ * virtual player_t::invalidate_cache( cache_e ) function. If the override reacts to a cache that is
+ * also invalidated as a dependent of another one ( eg. Attack Power ), add it to
+ * player_t::cache_hooks, so the dependent is passed through invalidate_cache( cache_e ) as well.
  *
  * Attention: player_t::invalidate_cache( cache_e ) is recursive and may call itself again.
  */
 struct player_stat_cache_t
 {
+  static_assert( CACHE_MAX <= 64, "Stat cache valid-states must fit in 64 bits" );
+  static_assert( SCHOOL_MAX + 1 <= 64, "Per-school valid-states must fit in 64 bits" );
+
+  // Per cache access statistics, collected with stat_cache_counters=1
+  struct counter_t
+  {
+    uint64_t hits, misses, invalidations;
+  };
+
   const player_t* player;
-  mutable std::array<bool, CACHE_MAX> valid;
-  mutable std::array < bool, SCHOOL_MAX + 1 > spell_power_valid, player_mult_valid, player_heal_mult_valid;
-  // 'valid'-states
+  // 'valid'-states, one bit per cache_e, and one bit per school for the per-school caches
+  mutable uint64_t valid;
+  mutable uint64_t spell_power_valid, player_mult_valid, player_heal_mult_valid;
+  mutable std::array<counter_t, CACHE_MAX> counters;
+  bool count;
 private:
   // cached values
   mutable double _strength, _agility, _stamina, _intellect, _spirit;
@@ -3324,8 +3616,32 @@ public:
   bool active; // runtime active-flag
   void invalidate_all();
   void invalidate( cache_e );
+  void invalidate( uint64_t mask );
+  void reset_counters();
+  void merge( const player_stat_cache_t& other );
   double get_attribute( attribute_e ) const;
-  player_stat_cache_t( const player_t* p ) : player( p ), active( false ) { invalidate_all(); }
+  player_stat_cache_t( const player_t* p ) :
+    player( p ), valid( 0 ), spell_power_valid( 0 ), player_mult_valid( 0 ), player_heal_mult_valid( 0 ),
+    count( false ), active( false )
+  { reset_counters(); }
+
+  // Test the valid-state of a cache, counting the access when enabled
+  bool check( cache_e c ) const
+  { return check( valid, c, c ); }
+  bool check( uint64_t mask, cache_e c, unsigned bit ) const
+  {
+    bool hit = ( mask >> bit ) & 1;
+    if ( count )
+    {
+      if ( hit ) counters[ c ].hits++;
+      else counters[ c ].misses++;
+    }
+    return hit;
+  }
+  void validate( cache_e c ) const
+  { valid |= uint64_t( 1 ) << c; }
+  static void validate( uint64_t& mask, unsigned bit )
+  { mask |= uint64_t( 1 ) << bit; }
 #if defined(SC_USE_STAT_CACHE)
   // Cache stat functions
   double strength() const;
@@ -3456,6 +3772,9 @@ struct player_collected_data_t
   extended_sample_data_t target_metric;
   mutex_t target_metric_mutex;
 
+  // Scale metric batched by iteration index ( common_random_numbers=1 )
+  crn_batch_means_t crn_scaling_metric;
+
   std::vector<simple_sample_data_t> resource_lost, resource_gained;
   struct resource_timeline_t
   {
@@ -3858,6 +4177,7 @@ struct player_t : public actor_t
 
   // Option Parsing
   std::vector<std::unique_ptr<option_t>> options;
+  opts::option_index_t option_index;
 
   // Stat Timelines to Display
   std::vector<stat_e> stat_timelines;
@@ -4479,6 +4799,11 @@ struct player_t : public actor_t
 
   // Stat Caching
   player_stat_cache_t cache;
+  // Caches invalidated along with each cache ( itself included ), built on reset
+  std::array<uint64_t, CACHE_MAX> cache_closure;
+  // Caches the class module hooks in invalidate_cache(), also when invalidated as a dependent
+  uint64_t cache_hooks;
+  void init_cache_closure();
 #if defined(SC_USE_STAT_CACHE)
   virtual void invalidate_cache( cache_e c );
 #else
@@ -4680,6 +5005,7 @@ struct player_t : public actor_t
   virtual void analyze( sim_t& );
 
   scaling_metric_data_t scaling_for_metric( scale_metric_e metric ) const;
+  double iteration_scaling_for_metric( scale_metric_e metric ) const;
 
   void change_position( position_e );
   position_e position() const
@@ -4690,8 +5016,9 @@ struct player_t : public actor_t
   virtual bool requires_data_collection() const
   { return active_during_iteration; }
 
-  rng::rng_t& rng() { return sim -> rng(); }
-  rng::rng_t& rng() const { return sim -> rng(); }
+  mutable crn_stream_t crn_stream;
+  rng::rng_t& rng() { return sim -> common_random_numbers ? sim -> crn_rng( crn_stream ) : sim -> rng(); }
+  rng::rng_t& rng() const { return sim -> common_random_numbers ? sim -> crn_rng( crn_stream ) : sim -> rng(); }
   auto_dispose<std::vector<action_variable_t*>> variables;
   // Add 1ms of time to ensure that we finish this run. This is necessary due
   // to the millisecond accuracy in our timing system.
@@ -4888,6 +5215,10 @@ public:
   // player_t::execute_action().
   uint64_t visited_apls_;
 
+  // if= expression evaluations made by action_t::ready() and skipped through
+  // cache_action_readiness. Summed over all iterations.
+  uint64_t ready_evaluations, ready_evaluations_saved;
+
   // Internal counter for action priority lists, used to set
   // action_priority_list_t::internal_id for lists.
   unsigned action_list_id_;
@@ -4950,22 +5281,82 @@ public:
   target_specific_t( bool owner = true ) : owner_( owner )
   { }
 
+  // Only non-owning tables (plain lookup caches) may be copied
+  target_specific_t( const target_specific_t& other ) : owner_( other.owner_ ), data( other.data )
+  { assert( ! owner_ && other.arena.empty() ); }
+
   T*& operator[](  const player_t* target ) const
   {
     assert( target );
     if ( data.size() <= target -> actor_index )
     {
-      data.resize( target -> actor_index + 1 );
+      // Size for every actor known to the sim at once, so the table is grown (at most) once per
+      // batch of spawned actors instead of once per new target
+      data.resize( std::max( target -> actor_index + 1, target -> sim -> actor_list.size() ) );
     }
     return data[ target -> actor_index ];
   }
+
+  // Construct a new T in the arena of this table, so the per-target data of one source stays
+  // mostly contiguous in memory. Most sources only ever touch a target or two, so the first chunk
+  // is small, and each following chunk doubles in size. Owned by the table, must not be deleted by
+  // the caller.
+  template <typename... Args>
+  T* construct( Args&&... args ) const
+  {
+    assert( owner_ );
+    if ( arena.empty() || arena.back().used == arena.back().capacity )
+    {
+      arena.emplace_back( arena.empty() ? 2 : arena.back().capacity * 2 );
+    }
+
+    chunk_t& chunk = arena.back();
+    T* obj = new ( &chunk.storage[ chunk.used ] ) T( std::forward<Args>( args )... );
+    chunk.used++;
+    return obj;
+  }
+
   ~target_specific_t()
   {
-    if ( owner_ )
-      range::dispose( data );
+    if ( ! owner_ )
+      return;
+
+    for ( auto& obj : data )
+    {
+      if ( obj && ! in_arena( obj ) )
+        delete obj;
+    }
+
+    for ( auto& chunk : arena )
+    {
+      for ( size_t i = 0; i < chunk.used; ++i )
+        reinterpret_cast<T*>( &chunk.storage[ i ] ) -> ~T();
+    }
   }
 private:
+  struct chunk_t
+  {
+    typedef typename std::aligned_storage<sizeof( T ), alignof( T )>::type slot_t;
+    std::unique_ptr<slot_t[]> storage;
+    size_t used, capacity;
+
+    chunk_t( size_t n ) : storage( new slot_t[ n ] ), used( 0 ), capacity( n )
+    { }
+  };
+
+  bool in_arena( const T* obj ) const
+  {
+    for ( const auto& chunk : arena )
+    {
+      const T* begin = reinterpret_cast<const T*>( chunk.storage.get() );
+      if ( std::less_equal<const T*>()( begin, obj ) && std::less<const T*>()( obj, begin + chunk.used ) )
+        return true;
+    }
+    return false;
+  }
+
   mutable std::vector<T*> data;
+  mutable std::vector<chunk_t> arena;
 };
 
 struct player_event_t : public event_t
@@ -5779,6 +6170,28 @@ public:
   cooldown_t line_cooldown;
   const action_priority_t* signature;
 
+  /**
+   * @brief Cached false result of the if= expression.
+   *
+   * Recorded with the state the expression read ( see expr_t::dependencies() ) when
+   * cache_action_readiness is enabled, and reused by ready() while the target and all of that
+   * state are unchanged.
+   */
+  struct if_expr_cache_t
+  {
+    bool valid;
+    player_t* target;
+    expr_dependencies_t dependencies;
+    std::vector<uint64_t> versions;
+    std::vector<double> values;
+
+    if_expr_cache_t() : valid( false ), target( nullptr )
+    { }
+  } if_expr_cache;
+
+  /// Random number stream of the action with common_random_numbers=1
+  mutable crn_stream_t crn_stream;
+
 
   /// State of the last execute()
   action_state_t* execute_state;
@@ -5790,6 +6203,20 @@ public:
 
   unsigned update_flags;
 
+  /**
+   * @brief Every target of the action must be snapshot in full.
+   *
+   * With the sim option aoe_snapshot_once, the source side of the state (everything outside
+   * STATE_TARGET) is snapshot once against the first target, with chain_target 0, and copied to
+   * the other targets. Set this on any action that
+   * - overrides snapshot_state() or snapshot_internal(), or
+   * - has a composite_da_multiplier(), composite_ta_multiplier(), composite_versatility(),
+   *   composite_persistent_multiplier() or pet multiplier that reads the state's target or
+   *   chain_target (e.g. a bonus to the primary target only).
+   * Target dependent modifiers that do not need this belong in the composite_target_*() methods.
+   */
+  bool custom_snapshot;
+
   /**
    * Target Cache System
    * - list: contains the cached target pointers
@@ -5808,6 +6235,19 @@ private:
   std::vector<std::unique_ptr<option_t>> options;
   action_state_t* state_cache;
   std::vector<travel_event_t*> travel_events;
+
+  /// Proc callbacks this action can trigger, flattened per ( proc_types, proc_types2 ) pair. Built on
+  /// first use, and rebuilt when the owner's callbacks or the weapon of the action change.
+  struct proc_callback_list_t
+  {
+    unsigned version;
+    const weapon_t* weapon;
+    std::vector<action_callback_t*> callbacks;
+    std::array<unsigned, PROC1_TYPE_MAX * PROC2_TYPE_MAX + 1> offsets;
+  };
+  std::unique_ptr<proc_callback_list_t> proc_callbacks;
+
+  void init_proc_callbacks();
 public:
   action_t( action_e type, const std::string& token, player_t* p, const spell_data_t* s = spell_data_t::nil() );
 
@@ -5851,6 +6291,9 @@ public:
 
   bool has_travel_events_for( const player_t* target ) const;
 
+  /// Trigger the owner's proc callbacks of the given type this action can proc
+  void trigger_proc_callbacks( proc_types pt, proc_types2 pt2, action_state_t* state );
+
   /** Determine if the action can have a resulting damage/heal amount > 0 */
   bool has_amount_result() const
   {
@@ -5868,10 +6311,10 @@ public:
   void reschedule_queue_event();
 
   rng::rng_t& rng()
-  { return sim -> rng(); }
+  { return sim -> common_random_numbers ? sim -> crn_rng( crn_stream ) : sim -> rng(); }
 
   rng::rng_t& rng() const
-  { return sim -> rng(); }
+  { return sim -> common_random_numbers ? sim -> crn_rng( crn_stream ) : sim -> rng(); }
 
   player_t* select_target_if_target();
 
@@ -6215,6 +6658,8 @@ public:
 
   virtual bool ready();
 
+  bool if_expr_ready();
+
   virtual void init();
 
   virtual bool init_finished();
@@ -6731,6 +7176,7 @@ private:
   timespan_t extended_time; // Added time per extend_duration for the current dot application
   timespan_t reduced_time; // Removed time per reduce_duration for the current dot application
   int stack;
+  uint64_t stack_version; // Bumped on every ticking or stack change
 public:
   event_t* tick_event;
   event_t* end_event;
@@ -6906,12 +7352,21 @@ struct action_callback_t : private noncopyable
   virtual void activate() { active = true; }
   virtual void deactivate() { active = false; }
 
+  // Whether the callback can ever trigger from the action. Used to pre-filter the per-action
+  // callback lists, so it may only depend on properties of the action that do not change in combat.
+  virtual bool can_proc( const action_t* ) const
+  { return true; }
+
   static void trigger( const std::vector<action_callback_t*>& v, action_t* a, void* call_data = nullptr )
+  { trigger( v, 0, v.size(), a, call_data ); }
+
+  // Trigger callbacks [ first, last ) of v
+  static void trigger( const std::vector<action_callback_t*>& v, std::size_t first, std::size_t last,
+                       action_t* a, void* call_data = nullptr )
   {
     if ( a && ! a -> player -> in_combat ) return;
 
-    std::size_t size = v.size();
-    for ( std::size_t i = 0; i < size; i++ )
+    for ( std::size_t i = first; i < last; i++ )
     {
       action_callback_t* cb = v[ i ];
       if ( cb -> active )
@@ -6974,6 +7429,9 @@ struct dbc_proc_callback_t : public action_callback_t
     assert( e.proc_flags() != 0 );
   }
 
+  // Random number stream of the callback with common_random_numbers=1, keyed in initialize()
+  mutable crn_stream_t crn_stream;
+
   dbc_proc_callback_t( const item_t* i, const special_effect_t& e ) :
     action_callback_t( i -> player ), item( *i ), effect( e ), cooldown( nullptr ),
     rppm( nullptr ), proc_chance( 0 ), ppm( 0 ),
@@ -6992,6 +7450,9 @@ struct dbc_proc_callback_t : public action_callback_t
 
   virtual void initialize() override;
 
+  bool can_proc( const action_t* a ) const override
+  { return ! weapon || a -> weapon == weapon; }
+
   void trigger( action_t* a, void* call_data ) override
   {
     if ( cooldown && cooldown -> down() ) return;
@@ -7048,7 +7509,10 @@ struct dbc_proc_callback_t : public action_callback_t
   }
 
   rng::rng_t& rng() const
-  { return listener -> rng(); }
+  {
+    return listener -> sim -> common_random_numbers ? listener -> sim -> crn_rng( crn_stream )
+                                                     : listener -> rng();
+  }
 
 private:
   bool roll( action_t* action )
@@ -8090,7 +8554,7 @@ inline std::string buff_t::source_name() const
   return "noone";
 }
 inline rng::rng_t& buff_t::rng()
-{ return sim -> rng(); }
+{ return sim -> common_random_numbers ? sim -> crn_rng( crn_stream ) : sim -> rng(); }
 // sim_t inlines
 
 inline buff_creator_t::operator buff_t* () const
@@ -8734,6 +9198,8 @@ void effect_callbacks_t<T_CB>::add_proc_callback( proc_types type,
   if ( sim -> debug )
     s << "Registering procs: ";
 
+  version++;
+
   // Setup the proc-on-X types for the proc
   for ( proc_types2 pt = PROC2_TYPE_MIN; pt < PROC2_TYPE_MAX; pt++ )
   {
@@ -8,6 +8,13 @@
 #include <thread>
 #include <mutex>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <exception>
 
 #if defined( SC_WINDOWS )
 #define NOMINMAX
@@ -35,31 +42,184 @@ public:
   { return m.native_handle(); }
 };
 
-class sc_thread_t::native_t
+namespace {
+
+// A unit of pooled work. Whoever claims the task first (a pool worker, or a thread joining the task
+// before any worker got to it) runs it.
+struct pool_task_t
 {
-private:
-  std::unique_ptr<std::thread> t;
+  std::function<void()> fn;
+  std::atomic<bool> claimed;
+
+  pool_task_t( std::function<void()> f ) : fn( std::move( f ) ), claimed( false )
+  { }
+
+  bool run()
+  {
+    if ( claimed.exchange( true ) )
+    {
+      return false;
+    }
+
+    fn();
+    return true;
+  }
+};
+
+/**
+ * Process-wide pool of persistent worker threads.
+ *
+ * All sc_thread_t objects (child sims of the main sim, scaling, plot, reforge plot and profileset
+ * sims) and thread::task_group_t tasks execute on the pool. Workers are created on demand, up to the
+ * thread budget of the simulation (see thread::set_pool_size), after which tasks are queued.
+ * Pooled tasks launch and join further pooled tasks (e.g., a profileset sim and its child sims), so
+ * a thread joining a task that is still queued runs it itself instead of waiting for a worker. The
+ * workers are stopped and joined when the process exits.
+ */
+class thread_pool_t
+{
+  std::mutex m;
+  std::condition_variable cv;
+  std::deque<std::shared_ptr<pool_task_t>> tasks;
+  std::vector<std::thread> workers;
+  size_t idle;
+  size_t max_workers;
+  bool stop;
+
+  thread_pool_t() : idle( 0 ), max_workers( std::max( 1U, std::thread::hardware_concurrency() ) ),
+    stop( false )
+  { }
+
+  void worker()
+  {
+    std::unique_lock<std::mutex> l( m );
+    while ( true )
+    {
+      ++idle;
+      cv.wait( l, [ this ]() { return stop || ! tasks.empty(); } );
+      --idle;
+
+      if ( tasks.empty() )
+      {
+        return;
+      }
+
+      auto task = std::move( tasks.front() );
+      tasks.pop_front();
+
+      l.unlock();
+      task -> run();
+      l.lock();
+    }
+  }
+
+public:
+  ~thread_pool_t()
+  {
+    {
+      std::lock_guard<std::mutex> l( m );
+      stop = true;
+    }
+    cv.notify_all();
+
+    for ( auto& worker : workers )
+    {
+      worker.join();
+    }
+  }
 
-  static void execute( sc_thread_t* t )
+  static thread_pool_t& instance()
   {
-    t -> run();
+    static thread_pool_t pool;
+    return pool;
   }
+
+  void set_max_workers( size_t n )
+  {
+    std::lock_guard<std::mutex> l( m );
+    max_workers = std::max( n, size_t( 1 ) );
+  }
+
+  void submit( std::shared_ptr<pool_task_t> task )
+  {
+    std::lock_guard<std::mutex> l( m );
+    tasks.push_back( std::move( task ) );
+    if ( idle < tasks.size() && workers.size() < max_workers )
+    {
+      workers.push_back( std::thread( &thread_pool_t::worker, this ) );
+    }
+    else
+    {
+      cv.notify_one();
+    }
+  }
+};
+
+} // unnamed namespace
+
+class sc_thread_t::native_t
+{
+private:
+  // Completion state of a single launch, shared with the pooled task
+  struct state_t
+  {
+    std::mutex m;
+    std::condition_variable cv;
+    bool done;
+    std::thread::id id;
+
+    state_t() : done( false ), id()
+    { }
+  };
+
+  std::shared_ptr<state_t> state;
+  std::shared_ptr<pool_task_t> task;
 public:
   native_t() :
-  t()
+  state(), task()
   { }
 
   std::thread::id id() const
-  { return t -> get_id(); }
+  {
+    if ( ! state )
+    {
+      return std::thread::id();
+    }
+
+    std::lock_guard<std::mutex> l( state -> m );
+    return state -> id;
+  }
 
   void launch( sc_thread_t* thr)
   {
-    t = std::unique_ptr<std::thread>( new std::thread( &sc_thread_t::native_t::execute, thr ) );
+    auto s = std::make_shared<state_t>();
+    state = s;
+    task = std::make_shared<pool_task_t>( [ s, thr ]() {
+      {
+        std::lock_guard<std::mutex> l( s -> m );
+        s -> id = std::this_thread::get_id();
+      }
+
+      thr -> run();
+
+      std::lock_guard<std::mutex> l( s -> m );
+      s -> done = true;
+      s -> cv.notify_all();
+    } );
+    thread_pool_t::instance().submit( task );
   }
 
   void join() {
-    if ( t && t -> joinable() ) {
-      t -> join();
+    if ( state )
+    {
+      // Not picked up by a worker yet, run it on the joining thread
+      if ( task -> run() )
+      {
+        return;
+      }
+
+      std::unique_lock<std::mutex> l( state -> m );
+      state -> cv.wait( l, [ this ]() { return state -> done; } );
     }
   }
 
@@ -211,4 +371,101 @@ void set_main_thread_priority()
 #else
 #endif
 }
+
+void set_pool_size( size_t n )
+{
+  thread_pool_t::instance().set_max_workers( n );
+}
+
+// task_group_t =============================================================
+
+struct task_group_t::state_t
+{
+  std::mutex m;
+  std::condition_variable cv;
+  std::vector<std::shared_ptr<pool_task_t>> tasks;
+  size_t pending;
+  std::exception_ptr error;
+
+  state_t() : pending( 0 )
+  { }
+};
+
+task_group_t::task_group_t() : state( new state_t() )
+{ }
+
+task_group_t::~task_group_t()
+{
+  try
+  {
+    wait();
+  }
+  catch ( ... )
+  {
+    // Already unwinding or not waited for, errors of the tasks are dropped
+  }
+}
+
+void task_group_t::run( std::function<void()> fn )
+{
+  state_t* s = state.get();
+  auto task = std::make_shared<pool_task_t>( [ s, fn ]() {
+    try
+    {
+      fn();
+    }
+    catch ( ... )
+    {
+      std::lock_guard<std::mutex> l( s -> m );
+      if ( ! s -> error )
+      {
+        s -> error = std::current_exception();
+      }
+    }
+
+    std::lock_guard<std::mutex> l( s -> m );
+    --s -> pending;
+    s -> cv.notify_all();
+  } );
+
+  {
+    std::lock_guard<std::mutex> l( s -> m );
+    s -> tasks.push_back( task );
+    ++s -> pending;
+  }
+
+  thread_pool_t::instance().submit( std::move( task ) );
+}
+
+bool task_group_t::wait_for( double seconds )
+{
+  std::unique_lock<std::mutex> l( state -> m );
+  return state -> cv.wait_for( l, std::chrono::duration<double>( seconds ),
+                               [ this ]() { return state -> pending == 0; } );
+}
+
+void task_group_t::wait()
+{
+  // Run the tasks no worker has picked up yet on the waiting thread
+  std::vector<std::shared_ptr<pool_task_t>> tasks;
+  {
+    std::lock_guard<std::mutex> l( state -> m );
+    tasks.swap( state -> tasks );
+  }
+
+  for ( auto& task : tasks )
+  {
+    task -> run();
+  }
+
+  std::unique_lock<std::mutex> l( state -> m );
+  state -> cv.wait( l, [ this ]() { return state -> pending == 0; } );
+
+  if ( state -> error )
+  {
+    auto error = state -> error;
+    state -> error = nullptr;
+    std::rethrow_exception( error );
+  }
 }
+} // thread
@@ -14,6 +14,7 @@
 #include "config.hpp"
 #include "generic.hpp"
 #include <memory>
+#include <functional>
 #include <thread>
 
 
@@ -76,4 +77,27 @@ namespace thread
 {
   // Windows (10) needs to promote main thread to higher priority
   void set_main_thread_priority();
+
+  // Limit the number of worker threads of the process-wide thread pool (the thread budget)
+  void set_pool_size( size_t );
+
+  /**
+   * A group of tasks executed on the process-wide thread pool.
+   *
+   * wait() runs the tasks not yet picked up by a pool worker on the calling thread, waits for the
+   * rest, and rethrows the first exception thrown by a task. The destructor waits for all tasks.
+   */
+  class task_group_t : private noncopyable
+  {
+    struct state_t;
+    std::unique_ptr<state_t> state;
+  public:
+    task_group_t();
+    ~task_group_t();
+
+    void run( std::function<void()> );
+    // Wait at most the given number of seconds, returns true when all tasks have finished
+    bool wait_for( double seconds );
+    void wait();
+  };
 }
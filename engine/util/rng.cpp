@@ -4,6 +4,7 @@
 // ==========================================================================
 //#include "dbc/dbc.hpp"
 
+#include <algorithm>
 #include <ctime>
 #include <stdint.h>
 #include <string>
@@ -54,6 +55,16 @@ double convert_to_double_0_1( uint64_t ui64 )
   return u.d - 1.0;
 }
 
+/// Bulk fill through the engine's own next_real(), without a virtual call per number
+template <typename Engine>
+void fill_from( Engine& engine, double* out, size_t n )
+{
+  for ( size_t i = 0; i < n; ++i )
+  {
+    out[ i ] = engine.Engine::next_real();
+  }
+}
+
 
 /**
  * @brief STL Mersenne twister MT19937
@@ -77,7 +88,7 @@ struct rng_mt_cxx11_t : public rng_t
     engine.seed( (unsigned) start ); 
   }
 
-  virtual double real() override
+  virtual double next_real() override
   { 
     return dist( engine );
   }
@@ -96,7 +107,7 @@ struct rng_mt_cxx11_64_t : public rng_t
     engine.seed( start );
   }
 
-  virtual double real() override
+  virtual double next_real() override
   {
     return convert_to_double_0_1(engine());
   }
@@ -129,10 +140,15 @@ struct rng_murmurhash_t : public rng_t
     x = start;
   }
 
-  virtual double real() override
+  virtual double next_real() override
   { 
     return convert_to_double_0_1( next() );
   }
+
+  virtual void fill( double* out, size_t n ) override
+  {
+    fill_from( *this, out, n );
+  }
 };
 
 
@@ -162,10 +178,15 @@ struct rng_xorshift64_t : public rng_t
     x = start;
   }
 
-  virtual double real() override
+  virtual double next_real() override
   { 
     return convert_to_double_0_1( next() );
   }
+
+  virtual void fill( double* out, size_t n ) override
+  {
+    fill_from( *this, out, n );
+  }
 };
 
 
@@ -199,10 +220,15 @@ struct rng_xorshift128_t : public rng_t
     s[ 1 ] = mmh.next();
   }
 
-  virtual double real() override
+  virtual double next_real() override
   { 
     return convert_to_double_0_1( next() );
   }
+
+  virtual void fill( double* out, size_t n ) override
+  {
+    fill_from( *this, out, n );
+  }
 };
 
 
@@ -237,10 +263,15 @@ struct rng_xorshift1024_t : public rng_t
     p = 0;
   }
 
-  virtual double real() override
+  virtual double next_real() override
   { 
     return convert_to_double_0_1( next() );
   }
+
+  virtual void fill( double* out, size_t n ) override
+  {
+    fill_from( *this, out, n );
+  }
 };
 
 
@@ -508,11 +539,37 @@ struct rng_sfmt_t : public rng_t
     dsfmt_chk_init_gen_rand( &dsfmt_global_data, (uint32_t) start ); 
   }
 
-  virtual double real() override
+  virtual double next_real() override
   { 
     return dsfmt_genrand_close_open( &dsfmt_global_data ) - 1.0; 
   }
 
+  /// Copy whole runs of the state array, regenerating it as needed
+  virtual void fill( double* out, size_t n ) override
+  {
+    const double* psfmt64 = &dsfmt_global_data.status[0].d[0];
+
+    while ( n > 0 )
+    {
+      if ( dsfmt_global_data.idx >= DSFMT_N64 )
+      {
+        dsfmt_gen_rand_all( &dsfmt_global_data );
+        dsfmt_global_data.idx = 0;
+      }
+
+      size_t count = std::min( n, static_cast<size_t>( DSFMT_N64 - dsfmt_global_data.idx ) );
+      const double* src = psfmt64 + dsfmt_global_data.idx;
+      for ( size_t i = 0; i < count; ++i )
+      {
+        out[ i ] = src[ i ] - 1.0;
+      }
+
+      dsfmt_global_data.idx += static_cast<int>( count );
+      out += count;
+      n -= count;
+    }
+  }
+
   /**
    * Special implementation because dsfmt only allows 32bit seed
    */
@@ -526,6 +583,85 @@ struct rng_sfmt_t : public rng_t
 };
 
 
+/**
+ * @brief Philox4x32-10 counter-based Random Number Generator
+ *
+ * Output block n is a keyed bijection of the counter n, so the generator has no state besides
+ * ( key, counter ). Seeding is free and any position of a stream can be generated directly, which
+ * makes it suitable for streams keyed by ( seed, iteration, source ).
+ *
+ * Salmon, Moraes, Dror, Shaw: Parallel Random Numbers: As Easy as 1, 2, 3 (SC11)
+ */
+struct rng_philox_t : public rng_t
+{
+  uint32_t key[ 2 ];
+  uint64_t counter;
+  uint32_t block[ 4 ];
+  unsigned index;
+
+  static void round( uint32_t ( &c )[ 4 ], const uint32_t ( &k )[ 2 ] )
+  {
+    uint64_t p0 = uint64_t( 0xD2511F53 ) * c[ 0 ];
+    uint64_t p1 = uint64_t( 0xCD9E8D57 ) * c[ 2 ];
+    uint32_t r[ 4 ] = { static_cast<uint32_t>( p1 >> 32 ) ^ c[ 1 ] ^ k[ 0 ], static_cast<uint32_t>( p1 ),
+                        static_cast<uint32_t>( p0 >> 32 ) ^ c[ 3 ] ^ k[ 1 ], static_cast<uint32_t>( p0 ) };
+    c[ 0 ] = r[ 0 ]; c[ 1 ] = r[ 1 ]; c[ 2 ] = r[ 2 ]; c[ 3 ] = r[ 3 ];
+  }
+
+  // Generate the output block of counter n
+  void generate( uint64_t n )
+  {
+    uint32_t k[ 2 ] = { key[ 0 ], key[ 1 ] };
+    block[ 0 ] = static_cast<uint32_t>( n );
+    block[ 1 ] = static_cast<uint32_t>( n >> 32 );
+    block[ 2 ] = block[ 3 ] = 0;
+
+    for ( int i = 0; i < 10; i++ )
+    {
+      if ( i > 0 )
+      {
+        k[ 0 ] += 0x9E3779B9;
+        k[ 1 ] += 0xBB67AE85;
+      }
+      round( block, k );
+    }
+  }
+
+  uint64_t next()
+  {
+    if ( index == 2 )
+    {
+      generate( counter++ );
+      index = 0;
+    }
+
+    uint64_t r = ( uint64_t( block[ 2 * index ] ) << 32 ) | block[ 2 * index + 1 ];
+    index++;
+    return r;
+  }
+
+  virtual const char* name() const override { return "philox"; }
+
+  virtual void seed( uint64_t start ) override
+  {
+    key[ 0 ] = static_cast<uint32_t>( start );
+    key[ 1 ] = static_cast<uint32_t>( start >> 32 );
+    counter = 0;
+    index = 2;
+  }
+
+  virtual double next_real() override
+  {
+    return convert_to_double_0_1( next() );
+  }
+
+  virtual void fill( double* out, size_t n ) override
+  {
+    fill_from( *this, out, n );
+  }
+};
+
+
 /**
  * @brief Tiny Mersenne Twister only 127 bit internal state
  *
@@ -616,11 +752,16 @@ struct rng_tinymt_t : public rng_t
     init( start );
   }
 
-  virtual double real() override
+  virtual double next_real() override
   {
     next_state();
     return temper_conv_open() - 1.0;
   }
+
+  virtual void fill( double* out, size_t n ) override
+  {
+    fill_from( *this, out, n );
+  }
 };
 
 } // unnamed
@@ -753,10 +894,39 @@ void rng_t::reset()
 {
   gauss_pair_value = 0;
   gauss_pair_use = false;
+  buffer_pos = buffer_end;
+}
+
+/// Buffered numbers are discarded, so this should be set before the rng is used
+void rng_t::set_buffer_size( size_t n )
+{
+  buffer.assign( n, 0.0 );
+  buffer_pos = buffer_end = buffer.data() + n;
+}
+
+/// Default bulk generation, one next_real() call per number
+void rng_t::fill( double* out, size_t n )
+{
+  for ( size_t i = 0; i < n; ++i )
+  {
+    out[ i ] = next_real();
+  }
+}
+
+double rng_t::refill()
+{
+  if ( buffer.empty() )
+  {
+    return next_real();
+  }
+
+  fill( buffer.data(), buffer.size() );
+  buffer_pos = buffer.data() + 1;
+  return buffer[ 0 ];
 }
 
 rng_t::rng_t() :
-    gauss_pair_value( 0.0 ), gauss_pair_use( false )
+    gauss_pair_value( 0.0 ), gauss_pair_use( false ), buffer(), buffer_pos( nullptr ), buffer_end( nullptr )
 {
 }
 
@@ -774,6 +944,7 @@ engine_type parse_type( const std::string& n )
   if( n == "xorshift64"   ) return engine_type::XORSHIFT64;
   if( n == "xorshift128"  ) return engine_type::XORSHIFT128;
   if( n == "xorshift1024" ) return engine_type::XORSHIFT1024;
+  if( n == "philox"       ) return engine_type::PHILOX;
 
   return engine_type::DEFAULT;
 }
@@ -806,6 +977,9 @@ std::unique_ptr<rng_t> create( engine_type t )
   case engine_type::XORSHIFT1024:
     return std::unique_ptr<rng_t>(new rng_xorshift1024_t());
 
+  case engine_type::PHILOX:
+    return std::unique_ptr<rng_t>(new rng_philox_t());
+
   case engine_type::DEFAULT:
   default:
     break;
@@ -1061,6 +1235,47 @@ static void monte_carlo( rng_t* rng, uint64_t n )
                ", numbers/sec = " << static_cast<uint64_t>( n * 1000.0 / elapsed_cpu ) << "\n\n";
 }
 
+// Compare every engine with and without bulk buffering, checking both produce the same numbers.
+static void test_buffered( engine_type type, uint64_t seed, uint64_t n )
+{
+  auto plain = create( type );
+  auto buffered = create( type );
+  buffered -> set_buffer_size( 256 );
+  plain -> seed( seed );
+  plain -> reset();
+  buffered -> seed( seed );
+  buffered -> reset();
+
+  for ( unsigned i = 0; i < 10000; ++i )
+  {
+    if ( plain -> real() != buffered -> real() )
+    {
+      std::cout << "rng::" << plain -> name() << ": buffered sequence differs at " << i << "\n";
+      return;
+    }
+  }
+
+  double time[ 2 ], sum[ 2 ];
+  rng_t* rngs[ 2 ] = { plain.get(), buffered.get() };
+  for ( unsigned r = 0; r < 2; ++r )
+  {
+    rng_t& rng = *rngs[ r ];
+    double s = 0;
+    int64_t start_time = milliseconds();
+    for ( uint64_t i = 0; i < n; ++i )
+    {
+      s += rng.real();
+    }
+    time[ r ] = static_cast<double>( milliseconds() - start_time );
+    sum[ r ] = s;
+  }
+
+  std::cout << std::setw( 12 ) << plain -> name()
+            << ": unbuffered = " << std::setw( 5 ) << time[ 0 ] << " ms"
+            << ", buffered = " << std::setw( 5 ) << time[ 1 ] << " ms"
+            << " (" << std::setprecision( 8 ) << sum[ 0 ] / n << ", " << sum[ 1 ] / n << ")\n";
+}
+
 } // namespace rng
 
 int main( int /*argc*/, char** /*argv*/ )
@@ -1073,6 +1288,7 @@ int main( int /*argc*/, char** /*argv*/ )
   rng_t* rng_tinymt = new rng_tinymt_t();
   rng_t* rng_xs128  = new rng_xorshift128_t();
   rng_t* rng_xs1024 = new rng_xorshift1024_t();
+  rng_t* rng_philox = new rng_philox_t();
 
   std::random_device rd;
   uint64_t seed  = uint64_t(rd()) | (uint64_t(rd()) << 32);
@@ -1086,6 +1302,7 @@ int main( int /*argc*/, char** /*argv*/ )
   rng_tinymt -> seed( seed );
   rng_xs128  -> seed( seed );
   rng_xs1024 -> seed( seed );
+  rng_philox -> seed( seed );
 
   uint64_t n = 100000000;
 
@@ -1096,6 +1313,7 @@ int main( int /*argc*/, char** /*argv*/ )
   test_one( rng_tinymt, n );
   test_one( rng_xs128,  n );
   test_one( rng_xs1024, n );
+  test_one( rng_philox, n );
 
   monte_carlo( rng_mt_cxx11,   n );
   monte_carlo( rng_murmurhash,   n );
@@ -1103,6 +1321,7 @@ int main( int /*argc*/, char** /*argv*/ )
   monte_carlo( rng_tinymt, n );
   monte_carlo( rng_xs128,  n );
   monte_carlo( rng_xs1024, n );
+  monte_carlo( rng_philox, n );
 
   test_seed( rng_mt_cxx11,   100000 );
   test_seed( rng_murmurhash,   100000 );
@@ -1110,6 +1329,16 @@ int main( int /*argc*/, char** /*argv*/ )
   test_seed( rng_tinymt, 100000 );
   test_seed( rng_xs128,  100000 );
   test_seed( rng_xs1024, 100000 );
+  test_seed( rng_philox, 100000 );
+
+  std::cout << n << " calls to real() per engine:\n";
+  for ( engine_type type : { engine_type::MURMURHASH, engine_type::SFMT, engine_type::STD,
+                             engine_type::TINYMT, engine_type::XORSHIFT64, engine_type::XORSHIFT128,
+                             engine_type::XORSHIFT1024, engine_type::PHILOX } )
+  {
+    test_buffered( type, seed, n );
+  }
+  std::cout << "\n";
 
 
   std::cout << "random device: min=" << rd.min() << " max=" << rd.max() << "\n\n";
@@ -10,6 +10,7 @@
 
 #include "config.hpp"
 #include <memory>
+#include <vector>
 #include "sc_timespan.hpp"
 
 /** \ingroup SC_RNG
@@ -20,7 +21,7 @@ namespace rng {
 
 /// rng engines
 enum class engine_type {
-  DEFAULT, MURMURHASH, SFMT, STD, TINYMT, XORSHIFT64, XORSHIFT128, XORSHIFT1024
+  DEFAULT, MURMURHASH, SFMT, STD, TINYMT, XORSHIFT64, XORSHIFT128, XORSHIFT1024, PHILOX
 };
 
 /**\ingroup SC_RNG
@@ -38,9 +39,17 @@ struct rng_t
   /// seed rng engine
   virtual void seed( uint64_t start ) = 0;
   /// uniform distribution in range [0,1]
-  virtual double real() = 0;
+  double real()
+  {
+    if ( buffer_pos != buffer_end )
+      return *buffer_pos++;
+    return refill();
+  }
   virtual uint64_t reseed();
   virtual void reset();
+  /// Serve real() from a buffer of n numbers generated in bulk ( 0 disables buffering ). The
+  /// sequence of numbers is the same as without buffering.
+  void set_buffer_size( size_t n );
 
   bool roll( double chance );
   double range( double min, double max );
@@ -52,10 +61,20 @@ struct rng_t
   timespan_t exgauss( timespan_t mean, timespan_t stddev, timespan_t nu );
 protected:
   rng_t();
+  /// next number of the engine, uniform distribution in range [0,1]
+  virtual double next_real() = 0;
+  /// fill out[0,n) with the next n numbers of the engine
+  virtual void fill( double* out, size_t n );
 private:
+  double refill();
+
   // Allow re-use of unused ( but necessary ) random number of a previous call to gauss()  
   double gauss_pair_value; 
   bool   gauss_pair_use;
+  // Bulk generated numbers, [buffer_pos, buffer_end) are unused
+  std::vector<double> buffer;
+  const double* buffer_pos;
+  const double* buffer_end;
 
 };
 
@@ -17,19 +17,73 @@
  */
 namespace statistics
 {
+namespace detail
+{
+/* Sum over contiguous data, accumulated in four independent lanes. Breaking up the serial
+ * dependency chain lets the compiler keep several additions in flight and vectorize them.
+ */
+template <typename T>
+T lane_sum( const T* data, size_t n )
+{
+  T lane[ 4 ] = {};
+  size_t i = 0;
+  for ( ; i + 4 <= n; i += 4 )
+  {
+    lane[ 0 ] += data[ i ];
+    lane[ 1 ] += data[ i + 1 ];
+    lane[ 2 ] += data[ i + 2 ];
+    lane[ 3 ] += data[ i + 3 ];
+  }
+
+  T sum = ( lane[ 0 ] + lane[ 1 ] ) + ( lane[ 2 ] + lane[ 3 ] );
+  for ( ; i < n; ++i )
+    sum += data[ i ];
+  return sum;
+}
+
+/* Sum of squared deviations from mean over contiguous data, see lane_sum
+ */
+template <typename T>
+T lane_squared_deviation( const T* data, size_t n, T mean )
+{
+  T lane[ 4 ] = {};
+  size_t i = 0;
+  for ( ; i + 4 <= n; i += 4 )
+  {
+    T d0 = data[ i ] - mean, d1 = data[ i + 1 ] - mean;
+    T d2 = data[ i + 2 ] - mean, d3 = data[ i + 3 ] - mean;
+    lane[ 0 ] += d0 * d0;
+    lane[ 1 ] += d1 * d1;
+    lane[ 2 ] += d2 * d2;
+    lane[ 3 ] += d3 * d3;
+  }
+
+  T sum = ( lane[ 0 ] + lane[ 1 ] ) + ( lane[ 2 ] + lane[ 3 ] );
+  for ( ; i < n; ++i )
+    sum += ( data[ i ] - mean ) * ( data[ i ] - mean );
+  return sum;
+}
+} // namespace detail
+
 /* Arithmetic Sum
  */
 template <typename Range>
-typename Range::value_type calculate_sum( Range r )
+typename Range::value_type calculate_sum( const Range& r )
 {
   using value_t = typename Range::value_type;
   return std::accumulate( std::begin( r ), std::end( r ), value_t{} );
 }
 
+template <typename T>
+T calculate_sum( const std::vector<T>& r )
+{
+  return detail::lane_sum( r.data(), r.size() );
+}
+
 /* Arithmetic Mean
  */
 template <typename Range>
-typename Range::value_type calculate_mean( Range r )
+typename Range::value_type calculate_mean( const Range& r )
 {
   auto length = std::distance( std::begin( r ), std::end( r ) );
   auto tmp    = calculate_sum( r );
@@ -40,7 +94,7 @@ typename Range::value_type calculate_mean( Range r )
 /* Expected Value of the squared deviation from a given mean
  */
 template <typename Range>
-typename Range::value_type calculate_variance( Range r,
+typename Range::value_type calculate_variance( const Range& r,
                                                typename Range::value_type mean )
 {
   using value_t = typename Range::value_type;
@@ -56,10 +110,19 @@ typename Range::value_type calculate_variance( Range r,
   return tmp;
 }
 
+template <typename T>
+T calculate_variance( const std::vector<T>& r, T mean )
+{
+  auto tmp = detail::lane_squared_deviation( r.data(), r.size(), mean );
+  if ( r.size() > 1 )
+    tmp /= r.size();
+  return tmp;
+}
+
 /* Expected Value of the squared deviation
  */
 template <typename Range>
-typename Range::value_type calculate_variance( Range r )
+typename Range::value_type calculate_variance( const Range& r )
 {
   return calculate_variance( r, calculate_mean( r ) );
 }
@@ -67,7 +130,7 @@ typename Range::value_type calculate_variance( Range r )
 /* Standard Deviation from a given mean
  */
 template <typename Range>
-typename Range::value_type calculate_stddev( Range r,
+typename Range::value_type calculate_stddev( const Range& r,
                                              typename Range::value_type mean )
 {
   return std::sqrt( calculate_variance( r, mean ) );
@@ -76,7 +139,7 @@ typename Range::value_type calculate_stddev( Range r,
 /* Standard Deviation
  */
 template <typename Range>
-typename Range::value_type calculate_stddev( Range r )
+typename Range::value_type calculate_stddev( const Range& r )
 {
   return std::sqrt( calculate_variance( r, calculate_mean( r ) ) );
 }
@@ -86,7 +149,7 @@ typename Range::value_type calculate_stddev( Range r )
  */
 template <typename Range>
 typename Range::value_type calculate_mean_stddev(
-    Range r, typename Range::value_type mean )
+    const Range& r, typename Range::value_type mean )
 {
   auto tmp    = calculate_variance( r, mean );
   auto length = std::distance( std::begin( r ), std::begin( r ) );
@@ -99,13 +162,13 @@ typename Range::value_type calculate_mean_stddev(
  * Limit Theorem
  */
 template <typename Range>
-typename Range::value_type calculate_mean_stddev( Range r )
+typename Range::value_type calculate_mean_stddev( const Range& r )
 {
   return calculate_mean_stddev( r, calculate_mean( r ) );
 }
 
 template <typename Range>
-std::vector<size_t> create_histogram( Range r, size_t num_buckets,
+std::vector<size_t> create_histogram( const Range& r, size_t num_buckets,
                                       typename Range::value_type min,
                                       typename Range::value_type max )
 {
@@ -137,7 +200,7 @@ std::vector<size_t> create_histogram( Range r, size_t num_buckets,
 }
 
 template <typename Range>
-std::vector<size_t> create_histogram( Range r, size_t num_buckets )
+std::vector<size_t> create_histogram( const Range& r, size_t num_buckets )
 {
   if ( std::begin( r ) == std::end( r ) )
     return std::vector<size_t>();
@@ -201,6 +264,204 @@ std::vector<double> create_normalized_histogram( iterator begin, iterator end,
   return normalize_histogram( create_histogram( begin, end, num_buckets ) );
 }
 
+/* Mergeable quantile sketch ( merging t-digest, Dunning & Ertl )
+ *
+ * Samples are buffered and periodically folded into a bounded set of weighted
+ * centroids. Centroid sizes are limited by the k1 scale function, which keeps
+ * the tails of the distribution at near full resolution while the bulk is
+ * summarized coarsely. Memory use is O( compression ), independent of the
+ * number of samples. Quantile and cdf queries require a compressed digest.
+ */
+class tdigest_t
+{
+  struct centroid_t
+  {
+    double mean, weight;
+
+    bool operator<( const centroid_t& other ) const
+    { return mean < other.mean; }
+  };
+
+  double _compression;
+  double _total_weight;
+  double _min, _max;
+  std::vector<centroid_t> _centroids;
+  std::vector<centroid_t> _buffer;
+
+  static constexpr double pi = 3.14159265358979323846;
+
+  size_t buffer_limit() const
+  { return static_cast<size_t>( 5 * _compression ); }
+
+  // k1 scale function and its inverse, k in [ -compression / 4, compression / 4 ]
+  double q_to_k( double q ) const
+  { return _compression / ( 2 * pi ) * std::asin( 2 * q - 1 ); }
+
+  double k_to_q( double k ) const
+  {
+    double kmax = _compression / 4;
+    if ( k >= kmax )
+      return 1.0;
+    return ( std::sin( k * 2 * pi / _compression ) + 1 ) / 2;
+  }
+
+public:
+  explicit tdigest_t( double compression = 100 )
+    : _compression( compression ),
+      _total_weight( 0 ),
+      _min( std::numeric_limits<double>::max() ),
+      _max( std::numeric_limits<double>::lowest() )
+  {
+  }
+
+  void add( double x, double weight = 1.0 )
+  {
+    _buffer.push_back( centroid_t{ x, weight } );
+    _total_weight += weight;
+    if ( x < _min )
+      _min = x;
+    if ( x > _max )
+      _max = x;
+
+    if ( _buffer.size() >= buffer_limit() )
+      compress();
+  }
+
+  void merge( const tdigest_t& other )
+  {
+    if ( other._total_weight == 0 )
+      return;
+
+    _buffer.insert( _buffer.end(), other._centroids.begin(), other._centroids.end() );
+    _buffer.insert( _buffer.end(), other._buffer.begin(), other._buffer.end() );
+    _total_weight += other._total_weight;
+    _min = std::min( _min, other._min );
+    _max = std::max( _max, other._max );
+
+    compress();
+  }
+
+  // Fold buffered samples into the centroid list
+  void compress()
+  {
+    if ( _buffer.empty() )
+      return;
+
+    _buffer.insert( _buffer.end(), _centroids.begin(), _centroids.end() );
+    std::sort( _buffer.begin(), _buffer.end() );
+    _centroids.clear();
+
+    centroid_t current   = _buffer.front();
+    double weight_so_far = 0;
+    double q_limit       = k_to_q( q_to_k( 0 ) + 1 );
+
+    for ( size_t i = 1, end = _buffer.size(); i < end; ++i )
+    {
+      const centroid_t& next = _buffer[ i ];
+      if ( ( weight_so_far + current.weight + next.weight ) / _total_weight <= q_limit )
+      {
+        current.weight += next.weight;
+        current.mean += ( next.mean - current.mean ) * next.weight / current.weight;
+      }
+      else
+      {
+        weight_so_far += current.weight;
+        _centroids.push_back( current );
+        q_limit = k_to_q( q_to_k( weight_so_far / _total_weight ) + 1 );
+        current = next;
+      }
+    }
+    _centroids.push_back( current );
+    _buffer.clear();
+  }
+
+  bool compressed() const
+  { return _buffer.empty(); }
+
+  double count() const
+  { return _total_weight; }
+
+  size_t size() const
+  { return _centroids.size(); }
+
+  /* Approximate q-quantile, q in [ 0, 1 ]. Interpolates linearly between
+   * centroid midpoints, and towards the exact min/max at the tails.
+   */
+  double quantile( double q ) const
+  {
+    assert( compressed() );
+
+    if ( _centroids.empty() )
+      return 0;
+    if ( _centroids.size() == 1 || q <= 0 )
+      return q <= 0 ? _min : _centroids.front().mean;
+    if ( q >= 1 )
+      return _max;
+
+    double index = q * _total_weight;
+
+    const centroid_t& first = _centroids.front();
+    if ( index < first.weight / 2 )
+      return _min + ( first.mean - _min ) * index / ( first.weight / 2 );
+
+    double cumulative = first.weight / 2;
+    for ( size_t i = 0, end = _centroids.size() - 1; i < end; ++i )
+    {
+      const centroid_t& left  = _centroids[ i ];
+      const centroid_t& right = _centroids[ i + 1 ];
+      double dw = ( left.weight + right.weight ) / 2;
+      if ( cumulative + dw > index )
+        return left.mean + ( right.mean - left.mean ) * ( index - cumulative ) / dw;
+      cumulative += dw;
+    }
+
+    const centroid_t& last = _centroids.back();
+    double remaining = std::min( 1.0, ( index - cumulative ) / ( last.weight / 2 ) );
+    return last.mean + ( _max - last.mean ) * remaining;
+  }
+
+  /* Approximate fraction of samples <= x
+   */
+  double cdf( double x ) const
+  {
+    assert( compressed() );
+
+    if ( _centroids.empty() || x < _min )
+      return 0;
+    if ( x >= _max )
+      return 1;
+
+    const centroid_t& first = _centroids.front();
+    if ( x < first.mean )
+      return ( first.weight / 2 ) * ( x - _min ) / ( first.mean - _min ) / _total_weight;
+
+    double cumulative = first.weight / 2;
+    for ( size_t i = 0, end = _centroids.size() - 1; i < end; ++i )
+    {
+      const centroid_t& left  = _centroids[ i ];
+      const centroid_t& right = _centroids[ i + 1 ];
+      double dw = ( left.weight + right.weight ) / 2;
+      if ( x < right.mean )
+        return ( cumulative + dw * ( x - left.mean ) / ( right.mean - left.mean ) ) / _total_weight;
+      cumulative += dw;
+    }
+
+    const centroid_t& last = _centroids.back();
+    if ( _max <= last.mean )
+      return 1;
+    return ( cumulative + ( last.weight / 2 ) * ( x - last.mean ) / ( _max - last.mean ) ) / _total_weight;
+  }
+
+  void clear()
+  {
+    _total_weight = 0;
+    _min          = std::numeric_limits<double>::max();
+    _max          = std::numeric_limits<double>::lowest();
+    _centroids.clear();
+    _buffer.clear();
+  }
+};
+
 }  // end sd namespace
 
 /* Simplest Samplest Data container. Only tracks sum and count
@@ -334,6 +595,11 @@ public:
 /* Extensive sample_data container with two runtime dependent modes:
  * - simple: Only offers sum, count
  *  -!simple: saves data and offers variance, percentiles, distribution, etc.
+ *
+ * The !simple mode can additionally be made streaming, in which case no
+ * samples are retained. Mean and variance are accumulated online ( Welford ),
+ * percentiles and the distribution are derived from a t-digest. Memory use is
+ * constant in the number of samples, data() and sorted_data() stay empty.
  */
 class extended_sample_data_t : public simple_sample_data_with_min_max_t
 {
@@ -347,6 +613,9 @@ public:
   bool simple;
 
 private:
+  bool _streaming;
+  value_t _running_mean, _m2;
+  statistics::tdigest_t _digest;
   std::vector<value_t> _data;
   std::vector<value_t> _sorted_data;  // extra sequence so we can keep the
                                       // original, unsorted order ( for example
@@ -363,6 +632,9 @@ public:
       mean_variance(),
       mean_std_dev(),
       simple( s ),
+      _streaming( false ),
+      _running_mean(),
+      _m2(),
       is_sorted( false )
   {
   }
@@ -374,6 +646,19 @@ public:
     clear();
   }
 
+  // Enable or disable streaming collection. Has no effect in simple mode.
+  void change_streaming( bool streaming )
+  {
+    _streaming = streaming;
+
+    clear();
+  }
+
+  bool streaming() const
+  {
+    return !simple && _streaming;
+  }
+
   const char* name() const
   {
     return name_str.c_str();
@@ -382,7 +667,7 @@ public:
   // Reserve memory
   void reserve( std::size_t capacity )
   {
-    if ( !simple )
+    if ( !simple && !_streaming )
       _data.reserve( capacity );
   }
 
@@ -393,6 +678,15 @@ public:
     {
       base_t::add( x );
     }
+    else if ( _streaming )
+    {
+      base_t::add( x );
+      value_t delta = x - _running_mean;
+      _running_mean += delta / base_t::count();
+      _m2 += delta * ( x - _running_mean );
+      _digest.add( x );
+      is_sorted = false;
+    }
     else
     {
       _data.push_back( x );
@@ -407,7 +701,7 @@ public:
 
   size_t size() const
   {
-    if ( simple )
+    if ( simple || _streaming )
       return base_t::count();
 
     return _data.size();
@@ -432,6 +726,13 @@ public:
     if ( simple )
       return;
 
+    if ( _streaming )
+    {
+      if ( base_t::count() )
+        _mean = _running_mean;
+      return;
+    }
+
     if ( data().empty() )
       return;
 
@@ -461,7 +762,7 @@ public:
   }
   size_t count() const
   {
-    return simple ? base_t::count() : data().size();
+    return simple || _streaming ? base_t::count() : data().size();
   }
 
   /* Analyze Variance: Variance, Stddev and Stddev of the mean
@@ -472,16 +773,19 @@ public:
     if ( simple )
       return;
 
-    if ( _data.empty() )
+    if ( count() == 0 )
       return;
 
-    variance = statistics::calculate_variance( data(), mean() );
+    if ( _streaming )
+      variance = count() > 1 ? _m2 / count() : _m2;
+    else
+      variance = statistics::calculate_variance( data(), mean() );
     std_dev  = std::sqrt( variance );
 
     // Calculate Standard Deviation of the Mean ( Central Limit Theorem )
-    if ( data().size() > 1 )
+    if ( count() > 1 )
     {
-      mean_variance = variance / data().size();
+      mean_variance = variance / count();
       mean_std_dev  = std::sqrt( mean_variance );
     }
   }
@@ -498,6 +802,12 @@ public:
     {
       return;
     }
+    if ( _streaming )
+    {
+      _digest.compress();
+      is_sorted = true;
+      return;
+    }
     _sorted_data = _data;
     range::sort( _sorted_data );
     is_sorted = true;
@@ -512,6 +822,12 @@ public:
     if ( simple )
       return;
 
+    if ( _streaming )
+    {
+      create_streaming_histogram( num_buckets );
+      return;
+    }
+
     if ( data().empty() )
       return;
 
@@ -523,6 +839,15 @@ public:
   {
     base_t::_count = 0;
     base_t::_sum   = 0.0;
+    if ( _streaming )
+    {
+      base_t::_found = false;
+      base_t::_min   = std::numeric_limits<value_t>::max();
+      base_t::_max   = std::numeric_limits<value_t>::lowest();
+    }
+    _running_mean = 0.0;
+    _m2           = 0.0;
+    _digest.clear();
     _sorted_data.clear();
     _data.clear();
     distribution.clear();
@@ -538,12 +863,15 @@ public:
     if ( simple )
       return 0;
 
-    if ( data().empty() )
+    if ( count() == 0 )
       return 0;
 
     if ( !is_sorted )
       return base_t::nan();
 
+    if ( _streaming )
+      return _digest.quantile( x );
+
     // Should be improved to use linear interpolation
     return ( sorted_data()[ (int)( x * ( sorted_data().size() - 1 ) ) ] );
   }
@@ -560,11 +888,26 @@ public:
   void merge( const extended_sample_data_t& other )
   {
     assert( simple == other.simple );
+    assert( _streaming == other._streaming );
 
     if ( simple )
     {
       base_t::merge( other );
     }
+    else if ( _streaming )
+    {
+      // Chan et al. pairwise combination of the running moments
+      size_t n = base_t::count() + other.count();
+      if ( n == 0 )
+        return;
+      value_t delta = other._running_mean - _running_mean;
+      double weight = static_cast<double>( other.count() ) / n;
+      _m2 += other._m2 + delta * delta * base_t::count() * weight;
+      _running_mean += delta * weight;
+      base_t::merge( other );
+      _digest.merge( other._digest );
+      is_sorted = false;
+    }
     else
       _data.insert( _data.end(), other._data.begin(), other._data.end() );
   }
@@ -588,6 +931,37 @@ public:
     return s;
   }
 
+private:
+  /* Fixed-bin histogram over [ min, max ], from the cumulative distribution
+   * of the digest. Bin counts are rounded on the cumulative scale, so they sum
+   * up to count() exactly.
+   */
+  void create_streaming_histogram( unsigned int num_buckets )
+  {
+    distribution.clear();
+
+    if ( count() == 0 || !is_sorted )
+      return;
+
+    value_t min = base_t::min(), max = base_t::max();
+    if ( max <= min )
+      return;
+
+    distribution.assign( num_buckets, size_t{} );
+    size_t previous = 0;
+    for ( unsigned int i = 0; i < num_buckets; ++i )
+    {
+      size_t cumulative = count();
+      if ( i + 1 < num_buckets )
+      {
+        value_t edge = min + ( max - min ) * ( i + 1 ) / num_buckets;
+        cumulative = static_cast<size_t>( std::round( _digest.cdf( edge ) * count() ) );
+        cumulative = std::max( previous, std::min( cumulative, count() ) );
+      }
+      distribution[ i ] = cumulative - previous;
+      previous = cumulative;
+    }
+  }
 };  // sample_data_t
 
 #endif  // SAMPLE_DATA_HPP
@@ -2,11 +2,68 @@
 #include <iostream>
 #ifdef UNIT_TEST
 
-int main( int /*argc*/, char** /*argv*/ )
+#include <chrono>
+#include <random>
+
+/* Micro-benchmark for the timeline and statistics kernels used in the merge/analyze phase.
+ * Usage: timeline [timelines] [length]
+ */
+
+namespace {
+
+template <typename Fn>
+double time_ms( Fn fn )
+{
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>( end - start ).count();
+}
+
+} // unnamed namespace
+
+int main( int argc, char** argv )
 {
-  tl::timeline_t<double> x;
+  size_t num_timelines = argc > 1 ? std::stoul( argv[ 1 ] ) : 1000;
+  size_t length = argc > 2 ? std::stoul( argv[ 2 ] ) : 600;
+
+  std::mt19937_64 engine( 1 );
+  std::uniform_real_distribution<double> dist( 0.0, 1000.0 );
+
+  std::vector<timeline_t> timelines( num_timelines );
+  for ( auto& tl : timelines )
+  {
+    for ( size_t i = 0; i < length; ++i )
+      tl.add( i, dist( engine ) );
+  }
+
+  std::vector<double> divisor( length, static_cast<double>( num_timelines ) );
+
+  timeline_t merged;
+  double merge_ms = time_ms( [ & ]() {
+    for ( const auto& tl : timelines )
+      merged.merge( tl );
+  } );
+
+  double adjust_ms = time_ms( [ & ]() {
+    for ( auto& tl : timelines )
+      tl.adjust( divisor );
+  } );
+
+  double sink = 0;
+  double analyze_ms = time_ms( [ & ]() {
+    for ( const auto& tl : timelines )
+    {
+      double mean = tl.mean();
+      sink += mean + statistics::calculate_variance( tl.data(), mean ) + tl.min() + tl.max();
+    }
+  } );
 
-  std::cout << sizeof( double );
+  std::cout << "timelines=" << num_timelines << " length=" << length << "\n"
+            << "merge:   " << merge_ms << " ms\n"
+            << "adjust:  " << adjust_ms << " ms\n"
+            << "analyze: " << analyze_ms << " ms\n"
+            << "(checksum " << sink + merged.mean() << ")\n";
 
   return 0;
 }
@@ -107,17 +107,19 @@ public:
     {
       _data.resize( index + 1 );
     }
-    _data.at( index ) += value;
+    _data[ index ] += value;
   }
 
   // Adjust timeline by dividing through divisor timeline
   template <class A>
   void adjust( const std::vector<A>& divisor_timeline )
   {
+    double* data = _data.data();
+    const A* divisor = divisor_timeline.data();
 
-    for ( size_t j = 0, size = std::min( data().size(), divisor_timeline.size() ); j < size; j++ )
+    for ( size_t j = 0, size = std::min( _data.size(), divisor_timeline.size() ); j < size; j++ )
     {
-      _data[ j ] /= divisor_timeline[ j ];
+      data[ j ] /= divisor[ j ];
     }
   }
 
@@ -141,8 +143,10 @@ public:
   void merge( const timeline_t& other )
   {
     // merge shared range
-    for ( size_t j = 0, num_buckets = std::min( _data.size(), other.data().size() ); j < num_buckets; ++j )
-      _data[ j ] += other.data()[ j ];
+    double* data = _data.data();
+    const double* other_data = other._data.data();
+    for ( size_t j = 0, num_buckets = std::min( _data.size(), other._data.size() ); j < num_buckets; ++j )
+      data[ j ] += other_data[ j ];
 
     // if other is larger, insert tail
     if ( _data.size() < other.data().size() )
@@ -241,9 +245,8 @@ public:
   {
     if ( tl.data().empty() )
       return;
-    double min = *std::min_element( tl.data().begin(), tl.data().end() );
-    double max = *std::max_element( tl.data().begin(), tl.data().end() );
-    create_histogram( tl, num_buckets, min, max );
+    auto minmax = std::minmax_element( tl.data().begin(), tl.data().end() );
+    create_histogram( tl, num_buckets, *minmax.first, *minmax.second );
   }
 
   /* Create Histogram from extended sample data, with given min/max
@@ -264,9 +267,8 @@ public:
   {
     if ( sd.simple || sd.data().empty() )
       return;
-    double min = *std::min_element( sd.data().begin(), sd.data().end() );
-    double max = *std::max_element( sd.data().begin(), sd.data().end() );
-    create_histogram( sd, num_buckets, min, max );
+    auto minmax = std::minmax_element( sd.data().begin(), sd.data().end() );
+    create_histogram( sd, num_buckets, *minmax.first, *minmax.second );
   }
 
   /* Add a other histogram to this one.
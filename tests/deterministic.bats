@@ -0,0 +1,26 @@
+load test_helper
+
+# DPS values of the last sim
+function dps_values() {
+  echo "${output}" | sed -n -e 's/^ *DPS: *\([0-9.]*\).*/\1/p'
+}
+
+# First class profile of the profile directory
+function class_profile() {
+  ls "${SIMC_PROFILE_DIR}"/*.simc | head -1
+}
+
+@test "Deterministic sims produce the same results regardless of thread count" {
+  SIMC_PROFILE=$(class_profile)
+
+  sim deterministic=1 threads=1
+  [ "${status}" -eq 0 ]
+  single_dps="$(dps_values)"
+
+  sim deterministic=1 threads=4
+  [ "${status}" -eq 0 ]
+  threaded_dps="$(dps_values)"
+
+  [ -n "${single_dps}" ]
+  [ "${single_dps}" = "${threaded_dps}" ]
+}
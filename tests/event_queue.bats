@@ -0,0 +1,26 @@
+load test_helper
+
+# DPS values of the last sim
+function dps_values() {
+  echo "${output}" | sed -n -e 's/^ *DPS: *\([0-9.]*\).*/\1/p'
+}
+
+# First class profile of the profile directory
+function class_profile() {
+  ls "${SIMC_PROFILE_DIR}"/*.simc | head -1
+}
+
+@test "Timing wheel and hierarchical event queues produce the same results" {
+  SIMC_PROFILE=$(class_profile)
+
+  sim deterministic=1 threads=1 event_queue=wheel
+  [ "${status}" -eq 0 ]
+  wheel_dps="$(dps_values)"
+
+  sim deterministic=1 threads=1 event_queue=hierarchical
+  [ "${status}" -eq 0 ]
+  hierarchical_dps="$(dps_values)"
+
+  [ -n "${wheel_dps}" ]
+  [ "${wheel_dps}" = "${hierarchical_dps}" ]
+}
@@ -0,0 +1,51 @@
+load test_helper
+
+# CpuSeconds of the last sim
+function cpu_seconds() {
+  echo "${output}" | sed -n -e 's/^ *CpuSeconds *= *//p'
+}
+
+# DPS lines of the last sim
+function dps_lines() {
+  echo "${output}" | grep "^ *DPS:"
+}
+
+@test "Compiled expressions produce the same results as the tree evaluator" {
+  sim deterministic=1 threads=1 optimize_expressions=1 compile_expressions=0
+  [ "${status}" -eq 0 ]
+  tree_dps="$(dps_lines)"
+
+  sim deterministic=1 threads=1 optimize_expressions=1 compile_expressions=1
+  [ "${status}" -eq 0 ]
+  compiled_dps="$(dps_lines)"
+
+  [ -n "${tree_dps}" ]
+  [ "${tree_dps}" = "${compiled_dps}" ]
+}
+
+@test "Cached action readiness produces the same results as evaluating every check" {
+  sim deterministic=1 threads=1 cache_action_readiness=0
+  [ "${status}" -eq 0 ]
+  uncached_dps="$(dps_lines)"
+
+  sim deterministic=1 threads=1 cache_action_readiness=1
+  [ "${status}" -eq 0 ]
+  cached_dps="$(dps_lines)"
+
+  [ -n "${uncached_dps}" ]
+  [ "${uncached_dps}" = "${cached_dps}" ]
+}
+
+# Benchmark, set SIMC_ITERATIONS high enough (e.g. 5000) for the expression evaluation cost to
+# dominate the fixed init cost
+@test "Benchmark compiled expressions against the tree evaluator" {
+  sim deterministic=1 threads=1 optimize_expressions=1 compile_expressions=0
+  [ "${status}" -eq 0 ]
+  tree_cpu="$(cpu_seconds)"
+
+  sim deterministic=1 threads=1 optimize_expressions=1 compile_expressions=1
+  [ "${status}" -eq 0 ]
+  compiled_cpu="$(cpu_seconds)"
+
+  echo "# $(basename ${SIMC_PROFILE}): tree ${tree_cpu}s, compiled ${compiled_cpu}s" >&3
+}